@@ -14,6 +14,7 @@
 #include <iostream>
 #include <memory>
 #include <random>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <optional>
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/*
+ * This is an example (and a benchmark) of locality-confined ping-pong, which
+ * is performed with atomic and with hybrid reference counting of messages.
+ *
+ */
+
+#include "rotor.hpp"
+#include "dummy_supervisor.h"
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace r = rotor;
+
+struct ping_t {};
+struct pong_t {};
+
+struct pinger_t : public r::actor_base_t {
+    using timepoint_t = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+    using r::actor_base_t::actor_base_t;
+
+    void set_ponger_addr(const r::address_ptr_t &addr) { ponger_addr = addr; }
+    void set_pings(std::size_t pings) { pings_left = pings_count = pings; }
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&pinger_t::on_pong); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        start = std::chrono::high_resolution_clock::now();
+        send_ping();
+    }
+
+    void on_pong(r::message_t<pong_t> &) noexcept { send_ping(); }
+
+    void send_ping() noexcept {
+        if (pings_left) {
+            --pings_left;
+            send<ping_t>(ponger_addr);
+        } else {
+            std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+            double freq = ((double)pings_count) / diff.count();
+            std::cout << "pings finishes in " << diff.count() << "s, freq = " << std::fixed << std::setprecision(10)
+                      << freq << "\n";
+            do_shutdown();
+        }
+    }
+
+    timepoint_t start;
+    r::address_ptr_t ponger_addr;
+    std::size_t pings_left;
+    std::size_t pings_count;
+};
+
+struct ponger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void set_pinger_addr(const r::address_ptr_t &addr) { pinger_addr = addr; }
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&ponger_t::on_ping); });
+    }
+
+    void on_ping(r::message_t<ping_t> &) noexcept { send<pong_t>(pinger_addr); }
+
+  private:
+    r::address_ptr_t pinger_addr;
+};
+
+static void run(std::size_t count, bool hybrid_refcount) {
+    r::system_context_t ctx{};
+    auto timeout = boost::posix_time::milliseconds{500}; /* does not matter */
+    auto sup = ctx.create_supervisor<dummy_supervisor_t>().timeout(timeout).hybrid_refcount(hybrid_refcount).finish();
+
+    auto pinger = sup->create_actor<pinger_t>().timeout(timeout).autoshutdown_supervisor().finish();
+    auto ponger = sup->create_actor<ponger_t>().timeout(timeout).finish();
+    pinger->set_ponger_addr(ponger->get_address());
+    pinger->set_pings(count);
+    ponger->set_pinger_addr(pinger->get_address());
+
+    std::cout << (hybrid_refcount ? "hybrid" : "atomic") << " refcount, ";
+    sup->do_process();
+}
+
+int main(int argc, char **argv) {
+    std::size_t count = 1000000;
+    if (argc > 1) {
+        boost::conversion::try_lexical_convert(argv[1], count);
+    }
+
+    run(count, false);
+    run(count, true);
+    return 0;
+}
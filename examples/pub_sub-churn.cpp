@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/*
+ * This is a benchmark of subscription and unsubscription: many handlers
+ * subscribe to the same (broadcast) address, get a single message and
+ * unsubscribe. The subscription map is used directly, i.e. only the cost
+ * of subscription bookkeeping is measured.
+ *
+ */
+
+#include "rotor.hpp"
+#include "dummy_supervisor.h"
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace r = rotor;
+
+struct payload_t {};
+
+struct sub_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void on_payload(r::message_t<payload_t> &) noexcept { ++received; }
+
+    std::size_t received = 0;
+};
+
+struct churn_supervisor_t : public dummy_supervisor_t {
+    using dummy_supervisor_t::dummy_supervisor_t;
+
+    r::subscription_t &get_subscription() noexcept { return subscription_map; }
+};
+
+using timepoint_t = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+static double since(const timepoint_t &start) {
+    std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+    return diff.count();
+}
+
+int main(int argc, char **argv) {
+    std::size_t count = 100000;
+    if (argc > 1) {
+        boost::conversion::try_lexical_convert(argv[1], count);
+    }
+
+    r::system_context_t ctx{};
+    auto timeout = boost::posix_time::milliseconds{500}; /* does not matter */
+    auto sup = ctx.create_supervisor<churn_supervisor_t>().timeout(timeout).finish();
+    auto sub = sup->create_actor<sub_t>().timeout(timeout).finish();
+    sup->do_process();
+
+    auto pub_addr = sup->create_address();
+    auto &subscription = sup->get_subscription();
+    std::vector<r::subscription_info_ptr_t> infos;
+    infos.reserve(count);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        auto handler = r::wrap_handler(*sub, &sub_t::on_payload);
+        infos.emplace_back(subscription.materialize(r::subscription_point_t(handler, pub_addr)));
+    }
+    auto subscribed = since(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    sup->send<payload_t>(pub_addr);
+    sup->do_process();
+    auto delivered = since(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (auto &info : infos) {
+        subscription.forget(info);
+    }
+    auto unsubscribed = since(start);
+
+    std::cout << count << " handlers (" << sub->received << " calls), " << std::fixed << std::setprecision(4)
+              << "subscription: " << subscribed << "s, delivery: " << delivered
+              << "s, unsubscription: " << unsubscribed << "s\n";
+
+    infos.clear();
+    sup->do_shutdown();
+    sup->do_process();
+    return 0;
+}
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/*
+ * This is a benchmark of cross-thread messaging in the thread backend:
+ * the plain threads (producers) enqueue messages to the supervisor, which
+ * runs in its own thread and is busy with processing of the previous ones;
+ * so, the cost of wake up of the consumer thread is measured too.
+ *
+ */
+
+#include "rotor.hpp"
+#include "rotor/thread.hpp"
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace r = rotor;
+namespace rth = rotor::thread;
+namespace pt = boost::posix_time;
+
+namespace payload {
+struct sample_t {};
+} // namespace payload
+
+namespace message {
+using sample_t = r::message_t<payload::sample_t>;
+}
+
+using timepoint_t = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+struct consumer_t : r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    std::size_t expected = 0;
+    std::size_t received = 0;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&consumer_t::on_sample); });
+    }
+
+    void on_sample(message::sample_t &) noexcept {
+        if (++received == expected) {
+            do_shutdown();
+        }
+    }
+};
+
+static void run(std::size_t producers, std::size_t count) {
+    auto per_producer = count / producers;
+    auto total = per_producer * producers;
+
+    rth::system_context_thread_t ctx;
+    auto timeout = pt::milliseconds{100};
+    auto sup = ctx.create_supervisor<rth::supervisor_thread_t>().timeout(timeout).finish();
+    auto consumer = sup->create_actor<consumer_t>().timeout(timeout).autoshutdown_supervisor().finish();
+    consumer->expected = total;
+    while (consumer->access<r::details::to::state>() != r::state_t::OPERATIONAL) {
+        sup->do_process();
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < producers; ++i) {
+        threads.emplace_back([&]() {
+            auto &address = consumer->get_address();
+            for (std::size_t j = 0; j < per_producer; ++j) {
+                sup->enqueue(r::make_message<payload::sample_t>(address));
+            }
+        });
+    }
+    ctx.run();
+    std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    double freq = ((double)total) / diff.count();
+    std::cout << "producers: " << std::setw(2) << producers << ", " << total << " messages in " << std::fixed
+              << std::setprecision(4) << diff.count() << "s, freq = " << std::setprecision(0) << freq << "\n";
+}
+
+int main(int argc, char **argv) {
+    std::size_t count = 1000000;
+    if (argc > 1) {
+        boost::conversion::try_lexical_convert(argv[1], count);
+    }
+
+    for (std::size_t producers : {1, 4}) {
+        run(producers, count);
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/*
+ * This is a benchmark of inbound (inter-thread) messages queue: the
+ * intrusive MPSC queue, used by rotor, vs boost::lockfree::queue, which
+ * was used previously. The single consumer takes messages from 1, 4 and
+ * 16 producers.
+ *
+ */
+
+#include "rotor.hpp"
+#include <boost/lexical_cast.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace r = rotor;
+
+struct payload_t {};
+
+using messages_t = std::vector<r::message_base_t *>;
+using lockfree_queue_t = boost::lockfree::queue<r::message_base_t *>;
+
+struct lockfree_t {
+    lockfree_t() : queue{0} { queue.reserve_unsafe(64); }
+
+    void push(r::message_base_t *message) noexcept { queue.push(message); }
+
+    void consume(messages_t &received) noexcept {
+        r::message_base_t *message;
+        while (queue.pop(message)) {
+            received.push_back(message);
+        }
+    }
+
+    static constexpr const char *name = "boost::lockfree::queue";
+    lockfree_queue_t queue;
+};
+
+struct intrusive_t {
+    void push(r::message_base_t *message) noexcept { queue.push(message); }
+
+    void consume(messages_t &received) noexcept {
+        if (queue.drain(local)) {
+            while (!local.empty()) {
+                received.push_back(local.pop_front().detach());
+            }
+        }
+    }
+
+    static constexpr const char *name = "inbound_messages_queue_t";
+    r::inbound_messages_queue_t queue;
+    r::messages_queue_t local;
+};
+
+template <typename Queue> void run(std::size_t producers, std::size_t count) {
+    auto per_producer = count / producers;
+    auto total = per_producer * producers;
+    std::vector<messages_t> messages(producers);
+    for (auto &bucket : messages) {
+        for (std::size_t i = 0; i < per_producer; ++i) {
+            bucket.push_back(r::make_message<payload_t>(r::address_ptr_t{}).detach());
+        }
+    }
+
+    Queue queue;
+    messages_t received;
+    received.reserve(total);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (auto &bucket : messages) {
+        threads.emplace_back([&queue, &bucket]() {
+            for (auto message : bucket) {
+                queue.push(message);
+            }
+        });
+    }
+    while (received.size() < total) {
+        queue.consume(received);
+    }
+    std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    double freq = ((double)total) / diff.count();
+    std::cout << std::setw(26) << Queue::name << ", producers: " << std::setw(2) << producers << ", " << total
+              << " messages in " << std::fixed << std::setprecision(4) << diff.count()
+              << "s, freq = " << std::setprecision(0) << freq << "\n";
+
+    for (auto message : received) {
+        intrusive_ptr_release(message);
+    }
+}
+
+int main(int argc, char **argv) {
+    std::size_t count = 1000000;
+    if (argc > 1) {
+        boost::conversion::try_lexical_convert(argv[1], count);
+    }
+
+    for (std::size_t producers : {1, 4, 16}) {
+        run<lockfree_t>(producers, count);
+        run<intrusive_t>(producers, count);
+    }
+    return 0;
+}
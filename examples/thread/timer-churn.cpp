@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/*
+ * This is a benchmark of timers arming and cancellation in the thread
+ * backend: an actor arms many timers with random intervals (i.e. there are
+ * many live timers, like request timeouts), cancels them in random order,
+ * and then arms short timers and waits for their expiration.
+ *
+ */
+
+#include "rotor.hpp"
+#include "rotor/thread.hpp"
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace r = rotor;
+namespace rth = rotor::thread;
+namespace pt = boost::posix_time;
+
+using timepoint_t = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+static double since(const timepoint_t &start) {
+    std::chrono::duration<double> diff = std::chrono::high_resolution_clock::now() - start;
+    return diff.count();
+}
+
+struct churner_t : r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    std::size_t count = 0;
+    std::size_t fired = 0;
+    std::size_t cancelled = 0;
+    timepoint_t start;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<long> distribution(1, 3600);
+        std::vector<r::request_id_t> ids;
+        ids.reserve(count);
+
+        start = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto interval = pt::seconds{distribution(gen)};
+            ids.emplace_back(start_timer(interval, *this, &churner_t::on_timer));
+        }
+        auto armed = since(start);
+
+        std::shuffle(ids.begin(), ids.end(), gen);
+        start = std::chrono::high_resolution_clock::now();
+        for (auto id : ids) {
+            cancel_timer(id);
+        }
+        auto cancelled_time = since(start);
+
+        std::cout << count << " timers, " << std::fixed << std::setprecision(4) << "arming: " << armed
+                  << "s, cancellation: " << cancelled_time << "s\n";
+
+        start = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto interval = pt::microseconds{static_cast<long>(i % 1000)};
+            start_timer(interval, *this, &churner_t::on_timer);
+        }
+    }
+
+    void on_timer(r::request_id_t, bool cancel) noexcept {
+        if (cancel) {
+            ++cancelled;
+            return;
+        }
+        if (++fired == count) {
+            std::cout << fired << " timers expired in " << since(start) << "s\n";
+            do_shutdown();
+        }
+    }
+};
+
+int main(int argc, char **argv) {
+    std::size_t count = 100000;
+    if (argc > 1) {
+        boost::conversion::try_lexical_convert(argv[1], count);
+    }
+
+    rth::system_context_thread_t ctx;
+    auto timeout = pt::milliseconds{100};
+    auto sup = ctx.create_supervisor<rth::supervisor_thread_t>().timeout(timeout).finish();
+    auto churner = sup->create_actor<churner_t>().timeout(timeout).autoshutdown_supervisor().finish();
+    churner->count = count;
+    ctx.run();
+
+    return churner->cancelled == count && churner->fired == count ? 0 : 1;
+}
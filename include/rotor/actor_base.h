@@ -14,7 +14,9 @@
 #include "handler.h"
 #include "extended_error.h"
 #include "timer_handler.hpp"
+#include "request_table.h"
 #include <set>
+#include <unordered_map>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -146,6 +148,19 @@ struct ROTOR_API actor_base_t : public arc_base_t<actor_base_t> {
     request_builder_t<typename request_wrapper_t<R>::request_t>
     request_via(const address_ptr_t &dest_addr, const address_ptr_t &reply_addr, Args &&...args);
 
+    /** \brief returns scatter-gather request builder for the destination addresses
+     *
+     * The same request (constructed from `args`) is sent to each destination
+     * under a single request id and timeout; the aggregated reply
+     * (`request_traits_t<R>::gather::message_t`) is delivered to the "main"
+     * actor address.
+     *
+     * See {@link scatter_builder_t}.
+     */
+    template <typename R, typename... Args>
+    scatter_builder_t<typename request_wrapper_t<R>::request_t> scatter(const addresses_t &dest_addrs,
+                                                                        const Args &...args);
+
     /** \brief convenient method for constructing and sending response to a request
      *
      * `args` are forwarded to response payload constuction
@@ -315,6 +330,22 @@ struct ROTOR_API actor_base_t : public arc_base_t<actor_base_t> {
     template <typename Delegate, typename Method>
     request_id_t start_timer(const pt::time_duration &interval, Delegate &delegate, Method method) noexcept;
 
+    /** \brief spawns a new recurring timer
+     *
+     * The timer triggers every `interval`, until it is cancelled; the same
+     * timer identity is supplied to the callback on each triggering. The
+     * triggerings are scheduled against the original schedule, i.e. delays
+     * are not accumulated, and the missed ones (if the actor was too busy)
+     * are skipped.
+     *
+     * The timer handler is allocated only once, i.e. it is cheaper than
+     * re-starting one-shot timer from the callback.
+     *
+     * The signature of the `method` is the same as for `start_timer`.
+     */
+    template <typename Delegate, typename Method>
+    request_id_t start_periodic_timer(const pt::time_duration &interval, Delegate &delegate, Method method) noexcept;
+
     /** \brief cancels previously started timer
      *
      * If timer hasn't been triggered, then it is cancelled and the callback will be invoked
@@ -380,12 +411,42 @@ struct ROTOR_API actor_base_t : public arc_base_t<actor_base_t> {
     /** \brief timer-id to timer-handler map (type) */
     using timers_map_t = std::unordered_map<request_id_t, timer_handler_ptr_t>;
 
-    /** \brief list of ids of active requests (type) */
-    using requests_t = std::unordered_set<request_id_t>;
+    /** \brief list of active requests (type) */
+    using requests_t = request_list_t;
+
+    /** \brief identity of interned handler, i.e. its type and its backend (actor or plugin) */
+    struct handler_cache_key_t {
+        /** \brief pointer to unique handler type ( `typeid(Handler).name()` ) */
+        const void *handler_type;
+
+        /** \brief the object, which member function is invoked by the handler */
+        const void *backend;
+
+        /** \brief compares two keys for equality */
+        inline bool operator==(const handler_cache_key_t &other) const noexcept {
+            return handler_type == other.handler_type && backend == other.backend;
+        }
+    };
+
+    /** \brief hash calculator for the interned handler identity */
+    struct handler_cache_key_hash_t {
+        /** \brief returns hash for the key */
+        inline std::size_t operator()(const handler_cache_key_t &key) const noexcept {
+            auto seed = std::hash<const void *>()(key.handler_type);
+            auto value = std::hash<const void *>()(key.backend);
+            return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+        }
+    };
+
+    /** \brief interned handlers (type); handlers of the same type and backend differ by member function only */
+    using handlers_cache_t = std::unordered_multimap<handler_cache_key_t, handler_ptr_t, handler_cache_key_hash_t>;
 
     /** \brief triggers timer handler associated with the timer id */
     void on_timer_trigger(request_id_t request_id, bool cancelled) noexcept;
 
+    /** \brief schedules the next triggering of the recurring timer and triggers it */
+    void rearm_timer(timer_handler_base_t &handler) noexcept;
+
     /** \brief starts timer with pre-forged timer id (aka request-id */
     template <typename Delegate, typename Method>
     void start_timer(request_id_t request_id, const pt::time_duration &interval, Delegate &delegate,
@@ -449,6 +510,13 @@ struct ROTOR_API actor_base_t : public arc_base_t<actor_base_t> {
     /** \brief non-owning pointer to resources plugin */
     plugin::resources_plugin_t *resources = nullptr;
 
+    /** \brief interned pointer-to-member function handlers of the actor and its plugins
+     *
+     * The same handlers are reused for repeated subscriptions; the lookup is
+     * constant-time. The cache is dropped when actor starts shutting down.
+     */
+    handlers_cache_t handlers_cache;
+
     /** \brief finds plugin by plugin class identity
      *
      * `nullptr` is returned when plugin cannot be found
@@ -464,7 +532,7 @@ struct ROTOR_API actor_base_t : public arc_base_t<actor_base_t> {
     /** \brief timer-id to timer-handler map */
     timers_map_t timers_map;
 
-    /** \brief list of ids of active requests */
+    /** \brief list of active requests */
     requests_t active_requests;
 
     /** \brief set of currently proccessing states, i.e. init or shutdown
@@ -483,6 +551,7 @@ struct ROTOR_API actor_base_t : public arc_base_t<actor_base_t> {
     friend struct plugin::lifetime_plugin_t;
     friend struct supervisor_t;
     template <typename T> friend struct request_builder_t;
+    template <typename T> friend struct scatter_builder_t;
     template <typename T, typename M> friend struct accessor_t;
 };
 
@@ -8,9 +8,13 @@
 
 #include "arc.hpp"
 #include "forward.hpp"
+#include <vector>
 
 namespace rotor {
 
+struct joint_handlers_t;
+struct subscription_t;
+
 /** \struct address_t
  *  \brief Message subscription and delivery point
  *
@@ -49,8 +53,14 @@ struct address_t : public arc_base_t<address_t> {
     inline bool same_locality(const address_t &other) const noexcept { return this->locality == other.locality; }
 
   private:
+    using dispatch_table_t = std::vector<const joint_handlers_t *>;
+
     friend struct supervisor_t;
+    friend struct subscription_t;
     address_t(supervisor_t &sup, const void *locality_) : supervisor{sup}, locality{locality_} {}
+
+    /* address handlers indexed by message type id, maintained by locality leader subscriptions */
+    dispatch_table_t dispatch_table;
 };
 
 /** \brief intrusive pointer for address */
@@ -9,6 +9,7 @@
 #include <boost/intrusive_ptr.hpp>
 #include <boost/smart_ptr/intrusive_ref_counter.hpp>
 #include "rotor/export.h"
+#include <atomic>
 
 namespace rotor {
 
@@ -23,6 +24,101 @@ using counter_policy_t = boost::thread_safe_counter;
 /** \brief base class to inject ref-counter with the specified policiy */
 template <typename T> using arc_base_t = boost::intrusive_ref_counter<T, counter_policy_t>;
 
+/** \brief intrusive ref-counter, which might be non-atomic until the object is shared
+ *
+ * An object, confined to a single thread (locality), might be marked as local
+ * right after creation; then its counter is updated by plain (relaxed load and store)
+ * operations, i.e. without locked instructions. Once the object is `share()`d,
+ * every further counter update is atomic.
+ *
+ * The transition is one-way, and it must be performed by the owning thread
+ * before the object becomes reachable from other threads.
+ *
+ * Objects are shared by default; when the library is compiled with
+ * `BUILD_THREAD_UNSAFE` option, the counter is always non-atomic.
+ *
+ */
+template <typename T> struct hybrid_arc_base_t {
+    /** \brief the counter value type */
+    using value_t = unsigned int;
+
+    /** \brief initializes counter in shared (atomic) mode */
+    hybrid_arc_base_t() noexcept : counter{shared_flag} {}
+
+    /** \brief copied object starts with its own (zero) counter */
+    hybrid_arc_base_t(const hybrid_arc_base_t &) noexcept : counter{shared_flag} {}
+
+    /** \brief assignment does not touch the counter */
+    hybrid_arc_base_t &operator=(const hybrid_arc_base_t &) noexcept { return *this; }
+
+    /** \brief returns the amount of references to the object */
+    value_t use_count() const noexcept { return counter.load(std::memory_order_relaxed) & ~shared_flag; }
+
+    /** \brief returns `true` if counter is updated atomically */
+    bool is_shared() const noexcept { return counter.load(std::memory_order_relaxed) & shared_flag; }
+
+    /** \brief switches counter into non-atomic mode, should be invoked before the object is ever published
+     *
+     * As the object is not reachable from other threads yet, the flag is cleared
+     * with plain store, i.e. without locked instruction.
+     */
+    void make_local() noexcept {
+#ifndef ROTOR_REFCOUNT_THREADUNSAFE
+        counter.store(counter.load(std::memory_order_relaxed) & ~shared_flag, std::memory_order_relaxed);
+#endif
+    }
+
+    /** \brief switches counter into atomic mode, should be invoked before the object is published to other threads */
+    void share() noexcept {
+#ifndef ROTOR_REFCOUNT_THREADUNSAFE
+        if (!is_shared()) {
+            counter.fetch_or(shared_flag, std::memory_order_release);
+        }
+#endif
+    }
+
+    /** \brief deletes unreferenced object; might be hidden in `T` to customize deallocation */
+    static void destroy(const T *ptr) noexcept { delete ptr; }
+
+  protected:
+    ~hybrid_arc_base_t() = default;
+
+  private:
+    static constexpr value_t shared_flag = value_t{1} << (sizeof(value_t) * 8 - 1);
+
+    inline void add_ref() const noexcept {
+        auto value = counter.load(std::memory_order_relaxed);
+#ifndef ROTOR_REFCOUNT_THREADUNSAFE
+        if (value & shared_flag) {
+            counter.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+#endif
+        counter.store(value + 1, std::memory_order_relaxed);
+    }
+
+    inline bool release() const noexcept {
+        auto value = counter.load(std::memory_order_relaxed);
+#ifndef ROTOR_REFCOUNT_THREADUNSAFE
+        if (value & shared_flag) {
+            return counter.fetch_sub(1, std::memory_order_acq_rel) == (shared_flag | 1);
+        }
+#endif
+        counter.store(value - 1, std::memory_order_relaxed);
+        return (value & ~shared_flag) == 1;
+    }
+
+    friend void intrusive_ptr_add_ref(const hybrid_arc_base_t *ptr) noexcept { ptr->add_ref(); }
+
+    friend void intrusive_ptr_release(const hybrid_arc_base_t *ptr) noexcept {
+        if (ptr->release()) {
+            T::destroy(static_cast<const T *>(ptr));
+        }
+    }
+
+    mutable std::atomic<value_t> counter;
+};
+
 /** \brief alias for intrusive pointer */
 template <typename T> using intrusive_ptr_t = boost::intrusive_ptr<T>;
 
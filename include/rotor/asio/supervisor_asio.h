@@ -7,12 +7,12 @@
 //
 
 #include "rotor/supervisor.h"
+#include "rotor/timer_queue.h"
 #include "rotor/asio/export.h"
 #include "supervisor_config_asio.h"
 #include "system_context_asio.h"
 #include "forwarder.hpp"
 #include <boost/asio.hpp>
-#include <unordered_map>
 #include <memory>
 
 #if defined(_MSC_VER)
@@ -69,6 +69,7 @@ struct ROTOR_ASIO_API supervisor_asio_t : public supervisor_t {
     virtual void start() noexcept override;
     virtual void shutdown() noexcept override;
     virtual void enqueue(message_ptr_t message) noexcept override;
+    void enqueue_batch(messages_queue_t &messages) noexcept override;
     virtual void shutdown_finish() noexcept override;
 
     /** \brief an helper for creation {@link forwarder_t} */
@@ -89,26 +90,9 @@ struct ROTOR_ASIO_API supervisor_asio_t : public supervisor_t {
     void do_process() noexcept;
 
   protected:
-    /** \struct timer_t
-     * \brief boos::asio::deadline_timer with embedded timer handler */
-    struct timer_t : public asio::deadline_timer {
-
-        /** \brief non-owning pointer to timer handler */
-        timer_handler_base_t *handler;
-
-        /** \brief constructs timer using timer handler and boost asio io_context */
-        timer_t(timer_handler_base_t *handler_, asio::io_context &io_context)
-            : asio::deadline_timer(io_context), handler{handler_} {}
-    };
-
-    /** \brief unique pointer to timer */
-    using timer_ptr_t = std::unique_ptr<timer_t>;
-
-    /** \brief timer id to timer pointer mapping type */
-    using timers_map_t = std::unordered_map<request_id_t, timer_ptr_t>;
-
     void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept override;
-    void do_cancel_timer(request_id_t timer_id) noexcept override;
+    void do_cancel_timer(timer_handler_base_t &handler) noexcept override;
+    void schedule_process() noexcept override;
 
     /** \brief guard type : alias for asio executor_work_guard */
     using guard_t = asio::executor_work_guard<asio::io_context::executor_type>;
@@ -116,17 +100,28 @@ struct ROTOR_ASIO_API supervisor_asio_t : public supervisor_t {
     /** \brief alias for a guard */
     using guard_ptr_t = std::unique_ptr<guard_t>;
 
-    /** \brief timer id to timer pointer mapping */
-    timers_map_t timers_map;
-
     /** \brief config for the supervisor */
     supervisor_config_asio_t::strand_ptr_t strand;
 
+    /** \brief armed timers of the supervisor, ordered by deadline */
+    timer_queue_t timers;
+
+    /** \brief the single native timer, which is armed for the earliest deadline */
+    asio::steady_timer native_timer;
+
+    /** \brief the deadline, for which the native timer is armed */
+    timer_queue_t::clock_t::time_point native_deadline;
+
+    /** \brief whether there is pending wait of the native timer */
+    bool native_armed = false;
+
     /** \brief guard to control ownership of the io-context */
     guard_ptr_t guard;
 
   private:
     void invoke_shutdown() noexcept;
+    void arm_timer() noexcept;
+    void on_native_timer() noexcept;
 };
 
 template <typename Actor> inline boost::asio::io_context::strand &get_strand(Actor &actor) {
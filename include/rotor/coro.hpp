@@ -0,0 +1,356 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/** \file coro.hpp
+ * Optional C++20 coroutines support: requests, timers and discovery awaitables
+ *
+ * The header is not included by `rotor.hpp`; it requires C++20 compiler.
+ */
+
+#if !defined(__cpp_impl_coroutine)
+#error "rotor/coro.hpp requires C++20 coroutines support"
+#endif
+
+#include "rotor/supervisor.h"
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <string>
+#include <type_traits>
+
+namespace rotor {
+
+/// namespace for optional C++20 coroutines support
+namespace coro {
+
+/** \struct frame_arena_t
+ * \brief per-actor cache of coroutine frames
+ *
+ * The frames are bucketed by size classes (multiples of `granularity`); the
+ * released frames are kept in the free list of their class and re-used by
+ * the next coroutines of the actor, i.e. the steady flow does not touch heap.
+ * The frames, bigger than `max_frame`, are allocated from heap directly.
+ *
+ */
+struct frame_arena_t {
+    /** \brief the size step of frames size classes */
+    static constexpr std::size_t granularity = 64;
+
+    /** \brief the amount of size classes */
+    static constexpr std::size_t classes = 16;
+
+    /** \brief the max frame size, which is cached by the arena */
+    static constexpr std::size_t max_frame = granularity * classes;
+
+    frame_arena_t() noexcept = default;
+    frame_arena_t(const frame_arena_t &) = delete;
+    frame_arena_t &operator=(const frame_arena_t &) = delete;
+
+    ~frame_arena_t() {
+        for (auto &head : free_lists) {
+            while (head) {
+                auto next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+    }
+
+    /** \brief returns the memory block of at least `size` bytes */
+    void *allocate(std::size_t size) {
+        auto index = size_class(size);
+        if (index >= classes) {
+            return ::operator new(size);
+        }
+        if (auto block = free_lists[index]; block) {
+            free_lists[index] = block->next;
+            return block;
+        }
+        return ::operator new((index + 1) * granularity);
+    }
+
+    /** \brief caches the memory block, previously allocated with the same `size` */
+    void deallocate(void *ptr, std::size_t size) noexcept {
+        auto index = size_class(size);
+        if (index >= classes) {
+            ::operator delete(ptr);
+            return;
+        }
+        auto block = static_cast<block_t *>(ptr);
+        block->next = free_lists[index];
+        free_lists[index] = block;
+    }
+
+    /** \brief returns the amount of cached (free) blocks */
+    std::size_t cached() const noexcept {
+        std::size_t count = 0;
+        for (auto head : free_lists) {
+            for (; head; head = head->next) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+  private:
+    struct block_t {
+        block_t *next;
+    };
+
+    static std::size_t size_class(std::size_t size) noexcept { return (size + granularity - 1) / granularity - 1; }
+
+    std::array<block_t *, classes> free_lists = {};
+};
+
+struct actor_t;
+
+/** \struct task_t
+ * \brief fire-and-forget coroutine of an actor
+ *
+ * The coroutine starts eagerly, i.e. it runs until the first suspension
+ * point, and it is resumed from the supervisor context, when the awaited
+ * response arrives or the timer triggers. The frame is destroyed, when the
+ * coroutine finishes or when it is abandoned, i.e. when the awaited request
+ * or timer is cancelled, because the actor shuts down.
+ *
+ * When the coroutine is a method of `coro::actor_t` descendant, its frame is
+ * taken from the actor's frames arena.
+ *
+ */
+struct task_t {
+    /** \struct promise_type
+     * \brief the coroutine promise
+     */
+    struct promise_type {
+        /** \brief returns the (empty) task */
+        task_t get_return_object() noexcept { return {}; }
+
+        /** \brief the coroutine starts eagerly */
+        std::suspend_never initial_suspend() noexcept { return {}; }
+
+        /** \brief the frame is destroyed upon coroutine completion */
+        std::suspend_never final_suspend() noexcept { return {}; }
+
+        /** \brief no value is returned */
+        void return_void() noexcept {}
+
+        /** \brief exceptions are not supported */
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        /** \brief allocates the frame of the free coroutine */
+        static void *operator new(std::size_t size) { return allocate(size, nullptr); }
+
+        /** \brief returns the frame into heap */
+        static void operator delete(void *ptr, std::size_t size) noexcept { deallocate(ptr, size); }
+
+      protected:
+        /** \brief the frame is prefixed by the pointer to the arena, where it has been taken from */
+        static constexpr std::size_t header_size = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+        /** \brief allocates the frame from the arena (or from heap, if there is no arena) */
+        static void *allocate(std::size_t size, frame_arena_t *arena) {
+            auto block = static_cast<std::byte *>(arena ? arena->allocate(size + header_size)
+                                                        : ::operator new(size + header_size));
+            *reinterpret_cast<frame_arena_t **>(block) = arena;
+            return block + header_size;
+        }
+
+        /** \brief returns the frame into the arena, where it has been taken from */
+        static void deallocate(void *ptr, std::size_t size) noexcept {
+            auto block = static_cast<std::byte *>(ptr) - header_size;
+            auto arena = *reinterpret_cast<frame_arena_t **>(block);
+            if (arena) {
+                arena->deallocate(block, size + header_size);
+            } else {
+                ::operator delete(block);
+            }
+        }
+    };
+
+    /** \struct method_promise_t
+     * \brief the promise of the coroutine, which takes the actor (e.g. as its object) as the first parameter
+     *
+     * The promise is specific to the coroutine signature, so the allocation
+     * and deallocation functions are plain (non-template) members of the same
+     * class, i.e. they match each other.
+     */
+    template <typename Actor, typename... Args> struct method_promise_t : promise_type {
+        /** \brief allocates the frame of the actor's method coroutine */
+        static void *operator new(std::size_t size, Actor &self, Args &...) {
+            if constexpr (std::is_base_of_v<actor_t, Actor>) {
+                return allocate(size, &self.get_frame_arena());
+            } else {
+                return allocate(size, nullptr);
+            }
+        }
+
+        /** \brief returns the frame into the arena, where it has been taken from */
+        static void operator delete(void *ptr, std::size_t size) noexcept { deallocate(ptr, size); }
+    };
+};
+
+/** \struct request_awaiter_t
+ * \brief awaitable request, which resumes the coroutine with the response message
+ *
+ * The response is delivered directly to the awaiting coroutine, i.e. no
+ * subscription to the response is needed. The result of `co_await` is
+ * the intrusive pointer to the response message; in the case of timeout
+ * the response contains the error.
+ *
+ */
+template <typename R> struct [[nodiscard]] request_awaiter_t : response_receiver_t {
+    /** \brief possibly wrapped (into intrusive pointer) request type */
+    using request_t = typename request_wrapper_t<R>::request_t;
+
+    /** \brief request/response types helper */
+    using traits_t = request_traits_t<request_t>;
+
+    /** \brief intrusive pointer type for response message */
+    using response_ptr_t = typename traits_t::response::message_ptr_t;
+
+    /** \brief constructs request message (from `args`), but still does not dispath it */
+    template <typename... Args>
+    request_awaiter_t(actor_base_t &actor, const address_ptr_t &destination, Args &&...args)
+        : builder{actor.template request<R>(destination, std::forward<Args>(args)...)} {}
+
+    /** \brief sets the request timeout (mandatory), the request is sent upon `co_await` */
+    request_awaiter_t send(const pt::time_duration &value) && noexcept {
+        timeout = value;
+        return std::move(*this);
+    }
+
+    /** \brief see `request_builder_t::auto_cancel` */
+    request_awaiter_t auto_cancel(bool value = true) && noexcept {
+        builder.auto_cancel(value);
+        return std::move(*this);
+    }
+
+    /** \brief the request is never complete before suspension */
+    bool await_ready() const noexcept { return false; }
+
+    /** \brief actually dispatches the request */
+    void await_suspend(std::coroutine_handle<> coroutine) noexcept {
+        assert(!timeout.is_special() && "request timeout should be set via send()");
+        handle = coroutine;
+        (void)builder.deliver_to(*this).send(timeout);
+    }
+
+    /** \brief returns the response message */
+    response_ptr_t await_resume() noexcept { return std::move(response); }
+
+    void on_response(message_ptr_t message) noexcept override {
+        response.reset(static_cast<typename traits_t::response::message_t *>(message.get()));
+        handle.resume();
+    }
+
+    void on_abandon() noexcept override { handle.destroy(); }
+
+  private:
+    request_builder_t<request_t> builder;
+    pt::time_duration timeout = pt::not_a_date_time;
+    response_ptr_t response;
+    std::coroutine_handle<> handle;
+};
+
+/** \struct sleep_awaiter_t
+ * \brief awaitable one-shot timer of an actor
+ */
+struct [[nodiscard]] sleep_awaiter_t {
+    /** \brief records the timer interval, but still does not start it */
+    sleep_awaiter_t(actor_base_t &actor_, const pt::time_duration &interval_) noexcept
+        : actor{actor_}, interval{interval_} {}
+
+    /** \brief the timer never triggers before suspension */
+    bool await_ready() const noexcept { return false; }
+
+    /** \brief actually starts the timer */
+    void await_suspend(std::coroutine_handle<> coroutine) noexcept {
+        handle = coroutine;
+        actor.start_timer(interval, *this, &sleep_awaiter_t::on_timer);
+    }
+
+    /** \brief nothing is returned */
+    void await_resume() const noexcept {}
+
+    /** \brief resumes coroutine on timer triggering, or destroys it on timer cancellation */
+    void on_timer(request_id_t, bool cancelled) noexcept {
+        if (cancelled) {
+            handle.destroy();
+        } else {
+            handle.resume();
+        }
+    }
+
+  private:
+    actor_base_t &actor;
+    pt::time_duration interval;
+    std::coroutine_handle<> handle;
+};
+
+/** \struct actor_t
+ * \brief actor with coroutines support
+ *
+ * The multi-step flows can be written as coroutines (methods, returning
+ * `task_t`), which `co_await` requests, timers and names discovery, i.e.
+ * without a handler per response type and without the intermediate state in
+ * actor members. The frames of the coroutines are taken from the actor's arena.
+ *
+ * The pending coroutines are destroyed, when the actor shuts down.
+ *
+ */
+struct actor_t : actor_base_t {
+    using actor_base_t::actor_base_t;
+
+    /** \brief returns awaitable request to the destination address
+     *
+     * The `args` are forwarded for construction of the request; the
+     * request is sent upon `co_await`. The request timeout is mandatory,
+     * i.e. `send(timeout)` should be invoked on the awaiter.
+     *
+     */
+    template <typename R, typename... Args>
+    request_awaiter_t<R> co_request(const address_ptr_t &destination, Args &&...args) {
+        return request_awaiter_t<R>(*this, destination, std::forward<Args>(args)...);
+    }
+
+    /** \brief returns awaitable timer, which triggers after the interval */
+    sleep_awaiter_t sleep(const pt::time_duration &interval) noexcept { return sleep_awaiter_t(*this, interval); }
+
+    /** \brief returns awaitable discovery of the service name in the registry
+     *
+     * The result of `co_await` is the discovery response message
+     * (`message::discovery_response_t`), i.e. the service address or an error.
+     *
+     */
+    request_awaiter_t<payload::discovery_request_t> discover(const std::string &name) {
+        auto &registry = supervisor->get_registry_address();
+        assert(registry && "registry address is defined");
+        return request_awaiter_t<payload::discovery_request_t>(*this, registry, name);
+    }
+
+    /** \brief returns the arena of the coroutine frames of the actor */
+    inline frame_arena_t &get_frame_arena() noexcept { return frame_arena; }
+
+  protected:
+    /** \brief the arena of the coroutine frames */
+    frame_arena_t frame_arena;
+};
+
+} // namespace coro
+
+} // namespace rotor
+
+namespace std {
+/** \brief coroutines, which take an actor (e.g. as object) as the first parameter, use signature-specific promise */
+template <typename Actor, typename... Args> struct coroutine_traits<rotor::coro::task_t, Actor &, Args...> {
+    /** \brief the promise of the coroutine */
+    using promise_type = rotor::coro::task_t::method_promise_t<Actor, Args...>;
+};
+} // namespace std
@@ -11,9 +11,8 @@
 #include "rotor/ev/supervisor_config_ev.h"
 #include "rotor/ev/system_context_ev.h"
 #include "rotor/system_context.h"
+#include "rotor/timer_queue.h"
 #include <ev.h>
-#include <memory>
-#include <unordered_map>
 
 namespace rotor {
 namespace ev {
@@ -39,24 +38,6 @@ struct ROTOR_EV_API supervisor_ev_t : public supervisor_t {
     /** \brief injects templated supervisor_config_ev_builder_t */
     template <typename Supervisor> using config_builder_t = supervisor_config_ev_builder_t<Supervisor>;
 
-    /** \struct timer_t
-     * \brief inheritance of ev_timer, which holds rotor `timer_id`
-     */
-    struct timer_t : public ev_timer {
-
-        /** \brief intrusive pointer to ev supervistor (type) */
-        using supervisor_ptr_t = intrusive_ptr_t<supervisor_ev_t>;
-
-        /** \brief non-owning pointer to timer handler */
-        timer_handler_base_t *handler;
-
-        /** \brief intrusive pointer to the supervisor */
-        supervisor_ptr_t sup;
-    };
-
-    /** \brief an alias for unique pointer, holding `timer_t` */
-    using timer_ptr_t = std::unique_ptr<timer_t>;
-
     /** \brief constructs new supervisor from ev supervisor config */
     supervisor_ev_t(supervisor_config_ev_t &config);
     virtual void do_initialize(system_context_t *ctx) noexcept override;
@@ -65,6 +46,7 @@ struct ROTOR_EV_API supervisor_ev_t : public supervisor_t {
     void start() noexcept override;
     void shutdown() noexcept override;
     void enqueue(message_ptr_t message) noexcept override;
+    void enqueue_batch(messages_queue_t &messages) noexcept override;
     void shutdown_finish() noexcept override;
 
     /** \brief retuns ev-loop associated with the supervisor */
@@ -77,14 +59,15 @@ struct ROTOR_EV_API supervisor_ev_t : public supervisor_t {
     template <typename T> auto &access() noexcept;
 
   protected:
-    /** \brief a type for mapping `timer_id` to timer pointer */
-    using timers_map_t = std::unordered_map<request_id_t, timer_ptr_t>;
-
     /** \brief EV-specific trampoline function for `on_async` method */
     static void async_cb(EV_P_ ev_async *w, int revents) noexcept;
 
+    /** \brief EV-specific trampoline function for the native timer */
+    static void timer_cb(EV_P_ ev_timer *w, int revents) noexcept;
+
     void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept override;
-    void do_cancel_timer(request_id_t timer_id) noexcept override;
+    void do_cancel_timer(timer_handler_base_t &handler) noexcept override;
+    void schedule_process() noexcept override;
 
     /** \brief Process external messages (from inbound queue).
      *
@@ -107,13 +90,24 @@ struct ROTOR_EV_API supervisor_ev_t : public supervisor_t {
     /** \brief how much time spend in active inbound queue polling */
     ev_tstamp poll_duration;
 
-    /** \brief timer_id to timer map */
-    timers_map_t timers_map;
+    /** \brief armed timers of the supervisor, ordered by deadline */
+    timer_queue_t timers;
+
+    /** \brief the single native timer, which is armed for the earliest deadline */
+    ev_timer native_timer;
+
+    /** \brief the deadline, for which the native timer is armed */
+    timer_queue_t::clock_t::time_point native_deadline;
+
+    /** \brief whether the native timer is active (and holds the reference to the supervisor) */
+    bool native_armed = false;
 
     friend struct supervisor_ev_shutdown_t;
 
   private:
     void move_inbound_queue() noexcept;
+    void arm_timer() noexcept;
+    void on_native_timer() noexcept;
 };
 
 } // namespace ev
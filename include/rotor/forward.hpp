@@ -8,12 +8,16 @@
 #include <functional>
 #include "arc.hpp"
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <cstdint>
 
 namespace rotor {
 
 struct address_t;
 struct actor_base_t;
 struct handler_base_t;
+struct handler_key_t;
+struct message_base_t;
+struct request_entry_t;
 struct supervisor_t;
 struct system_context_t;
 
@@ -25,13 +29,20 @@ using actor_ptr_t = intrusive_ptr_t<actor_base_t>;
 /** \brief intrusive pointer for handler */
 using handler_ptr_t = intrusive_ptr_t<handler_base_t>;
 
+/** \brief direct (non-virtual) handler invoker, which does not check message type */
+using handler_thunk_t = void (*)(handler_base_t &, intrusive_ptr_t<message_base_t> &) noexcept;
+
 /** \brief intrusive pointer for supervisor */
 using supervisor_ptr_t = intrusive_ptr_t<supervisor_t>;
 
 namespace pt = boost::posix_time;
 
-/** \brief timer identifier type in the scope of the actor */
-using request_id_t = std::size_t;
+/** \brief timer identifier type in the scope of the actor
+ *
+ * The type is 64-bit wide on all platforms, as request ids encode slot and
+ * generation of the request table, see `request_table_t`.
+ */
+using request_id_t = std::uint64_t;
 
 /** \brief factory which allows to create actors lazily or on demand
  *
@@ -112,6 +112,20 @@ template <typename M, typename H> struct handler_traits<lambda_holder_t<M, H>> {
     static auto const constexpr is_lambda = true;
 };
 
+/** \struct handler_key_t
+ *  \brief Lightweight handler identity, i.e. handler type and actor
+ *
+ * It is used for lookups (e.g. for unsubscription) without constructing
+ * a handler.
+ */
+struct handler_key_t {
+    /** \brief pointer to unique handler type ( `typeid(Handler).name()` ) */
+    const void *handler_type;
+
+    /** \brief non-owning pointer to actor of the handler */
+    const actor_base_t *actor_ptr;
+};
+
 /** \struct handler_base_t
  *  \brief Base class for `rotor` handler, i.e concrete message type processing point
  * on concrete actor.
@@ -128,16 +142,32 @@ struct ROTOR_API handler_base_t : public arc_base_t<handler_base_t> {
     /** \brief precalculated hash for the handler */
     size_t precalc_hash;
 
+    /** \brief direct invoker of the handler
+     *
+     * It is the same as `call`, but without message type check and without
+     * virtual dispatch; used by delivery for already selected (by message type)
+     * handlers.
+     *
+     */
+    handler_thunk_t thunk;
+
     /** \brief constructs `handler_base_t` from raw pointer to actor, raw
-     * pointer to message type and raw pointer to handler type
+     * pointer to message type, raw pointer to handler type and the invoker.
+     *
+     * If the invoker is not provided, `call` is used.
      */
-    explicit handler_base_t(actor_base_t &actor, const void *handler_type_) noexcept;
+    explicit handler_base_t(actor_base_t &actor, const void *handler_type_, handler_thunk_t thunk_ = nullptr) noexcept;
 
     /** \brief compare two handler for equality */
     inline bool operator==(const handler_base_t &rhs) const noexcept {
         return handler_type == rhs.handler_type && actor_ptr == rhs.actor_ptr;
     }
 
+    /** \brief compare handler with the lightweight handler identity */
+    inline bool operator==(const handler_key_t &rhs) const noexcept {
+        return handler_type == rhs.handler_type && actor_ptr == rhs.actor_ptr;
+    }
+
     /** \brief attempt to delivery message to the handler
      *
      * The message is delivered only if its type matches to the handler message type,
@@ -192,6 +222,8 @@ struct handler_intercepted_t : public handler_base_t {
     const void *message_type() const noexcept override;
 
   private:
+    static void invoke(handler_base_t &self, message_ptr_t &message) noexcept;
+
     handler_ptr_t backend;
     const void *tag;
 };
@@ -213,6 +245,8 @@ inline constexpr bool is_plugin_handler_v =
 namespace {
 namespace to {
 struct actor {};
+struct handlers_cache {};
+struct state {};
 } // namespace to
 } // namespace
 } // namespace details
@@ -237,13 +271,11 @@ struct handler_t<Handler, std::enable_if_t<details::is_actor_handler_v<Handler>>
 
     /** \brief constructs handler from actor & pointer-to-member function  */
     explicit handler_t(actor_base_t &actor, Handler &&handler_)
-        : handler_base_t{actor, handler_type}, handler{handler_} {}
+        : handler_base_t{actor, handler_type, &invoke}, handler{handler_} {}
 
     void call(message_ptr_t &message) noexcept override {
         if (message->type_index == final_message_t::message_type) {
-            auto final_message = static_cast<final_message_t *>(message.get());
-            auto &final_obj = static_cast<backend_t &>(*actor_ptr);
-            (final_obj.*handler)(*final_message);
+            invoke(*this, message);
         }
     }
 
@@ -251,15 +283,18 @@ struct handler_t<Handler, std::enable_if_t<details::is_actor_handler_v<Handler>>
         return message->type_index == final_message_t::message_type;
     }
 
-    void call_no_check(message_ptr_t &message) noexcept override {
-        auto final_message = static_cast<final_message_t *>(message.get());
-        auto &final_obj = static_cast<backend_t &>(*actor_ptr);
-        (final_obj.*handler)(*final_message);
-    }
+    void call_no_check(message_ptr_t &message) noexcept override { invoke(*this, message); }
 
     const void *message_type() const noexcept override { return final_message_t::message_type; }
 
   private:
+    static void invoke(handler_base_t &self, message_ptr_t &message) noexcept {
+        auto &final_handler = static_cast<handler_t &>(self);
+        auto final_message = static_cast<final_message_t *>(message.get());
+        auto &final_obj = static_cast<backend_t &>(*final_handler.actor_ptr);
+        (final_obj.*final_handler.handler)(*final_message);
+    }
+
     using traits = handler_traits<Handler>;
     using backend_t = typename traits::backend_t;
     using final_message_t = typename traits::message_t;
@@ -285,13 +320,12 @@ struct handler_t<Handler, std::enable_if_t<details::is_plugin_handler_v<Handler>
 
     /** \brief ctor form plugin and plugin handler (pointer-to-member function of the plugin) */
     explicit handler_t(plugin::plugin_base_t &plugin_, Handler &&handler_)
-        : handler_base_t{*plugin_.access<details::to::actor>(), handler_type}, plugin{plugin_}, handler{handler_} {}
+        : handler_base_t{*plugin_.access<details::to::actor>(), handler_type, &invoke}, plugin{plugin_},
+          handler{handler_} {}
 
     void call(message_ptr_t &message) noexcept override {
         if (message->type_index == final_message_t::message_type) {
-            auto final_message = static_cast<final_message_t *>(message.get());
-            auto &final_obj = static_cast<backend_t &>(plugin);
-            (final_obj.*handler)(*final_message);
+            invoke(*this, message);
         }
     }
 
@@ -299,15 +333,18 @@ struct handler_t<Handler, std::enable_if_t<details::is_plugin_handler_v<Handler>
         return message->type_index == final_message_t::message_type;
     }
 
-    void call_no_check(message_ptr_t &message) noexcept override {
-        auto final_message = static_cast<final_message_t *>(message.get());
-        auto &final_obj = static_cast<backend_t &>(plugin);
-        (final_obj.*handler)(*final_message);
-    }
+    void call_no_check(message_ptr_t &message) noexcept override { invoke(*this, message); }
 
     const void *message_type() const noexcept override { return final_message_t::message_type; }
 
   private:
+    static void invoke(handler_base_t &self, message_ptr_t &message) noexcept {
+        auto &final_handler = static_cast<handler_t &>(self);
+        auto final_message = static_cast<final_message_t *>(message.get());
+        auto &final_obj = static_cast<backend_t &>(final_handler.plugin);
+        (final_obj.*final_handler.handler)(*final_message);
+    }
+
     using traits = handler_traits<Handler>;
     using backend_t = typename traits::backend_t;
     using final_message_t = typename traits::message_t;
@@ -335,12 +372,11 @@ struct handler_t<lambda_holder_t<Handler, M>,
 
     /** \brief constructs handler from actor & lambda wrapper */
     explicit handler_t(actor_base_t &actor, handler_backend_t &&handler_)
-        : handler_base_t{actor, handler_type}, handler{std::forward<handler_backend_t>(handler_)} {}
+        : handler_base_t{actor, handler_type, &invoke}, handler{std::forward<handler_backend_t>(handler_)} {}
 
     void call(message_ptr_t &message) noexcept override {
         if (message->type_index == final_message_t::message_type) {
-            auto final_message = static_cast<final_message_t *>(message.get());
-            handler.fn(*final_message);
+            invoke(*this, message);
         }
     }
 
@@ -348,14 +384,16 @@ struct handler_t<lambda_holder_t<Handler, M>,
         return message->type_index == final_message_t::message_type;
     }
 
-    void call_no_check(message_ptr_t &message) noexcept override {
-        auto final_message = static_cast<final_message_t *>(message.get());
-        handler.fn(*final_message);
-    }
+    void call_no_check(message_ptr_t &message) noexcept override { invoke(*this, message); }
 
     const void *message_type() const noexcept override { return final_message_t::message_type; }
 
   private:
+    static void invoke(handler_base_t &self, message_ptr_t &message) noexcept {
+        auto final_message = static_cast<final_message_t *>(message.get());
+        static_cast<handler_t &>(self).handler.fn(*final_message);
+    }
+
     using final_message_t = typename handler_backend_t::message_t;
 };
 
@@ -9,7 +9,10 @@
 #include "arc.hpp"
 #include "address.hpp"
 #include <typeindex>
-#include <deque>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -18,16 +21,79 @@
 
 namespace rotor {
 
+struct message_pool_t;
+struct messages_queue_t;
+struct inbound_messages_queue_t;
+
+namespace message_support {
+/** \brief returns unique pointer for the message type */
+ROTOR_API const void *register_type(const std::type_index &type_index) noexcept;
+
+/** \brief returns dense (small integer) id for the message type */
+ROTOR_API std::uint32_t register_type_id(const std::type_index &type_index) noexcept;
+
+/** \brief returns dense id for the message type pointer, obtained via `register_type` */
+ROTOR_API std::uint32_t get_type_id(const void *message_type) noexcept;
+} // namespace message_support
+
+/** \struct message_link_t
+ *  \brief intrusive hook, which links messages in queues
+ *
+ * A message might be linked into one queue (local or inbound) at a time.
+ */
+struct message_link_t {
+    message_link_t() noexcept = default;
+
+    /** \brief the link is never copied */
+    message_link_t(const message_link_t &) noexcept {}
+
+    /** \brief the link is never copied */
+    message_link_t &operator=(const message_link_t &) noexcept { return *this; }
+
+    /** \brief the next link in a queue */
+    std::atomic<message_link_t *> next_link{nullptr};
+};
+
+/** \brief delivery lane of a message */
+enum class message_lane_t : std::uint8_t {
+    /** \brief rotor control-plane messages (actors initialization, shutdown, subscriptions, linking) */
+    control = 0,
+    /** \brief all other messages */
+    user = 1,
+};
+
+/** \struct message_lane_trait_t
+ *  \brief defines the delivery lane of messages with the `T` payload
+ *
+ * The trait should be specialized to put messages into the control lane.
+ */
+template <typename T> struct message_lane_trait_t {
+    /** \brief the lane of the messages */
+    static constexpr message_lane_t lane = message_lane_t::user;
+};
+
+/** \struct control_lane_trait_t
+ *  \brief helper base for `message_lane_trait_t` specializations of control-plane payloads
+ */
+struct control_lane_trait_t {
+    /** \brief the lane of the messages */
+    static constexpr message_lane_t lane = message_lane_t::control;
+};
+
 /** \struct message_base_t
  *  \brief Base class for `rotor` message.
  *
  *  The base class contains destinanation address (in the form of intrusive
  *  pointer to `address_t`) and possibility to detect final message type.
  *
+ *  Messages created in the locality context might use non-atomic reference
+ *  counting until they are forwarded to a different locality, see
+ *  `hybrid_arc_base_t`.
+ *
  * The actual message payload meant to be provided by derived classes
  *
  */
-struct message_base_t : public arc_base_t<message_base_t> {
+struct message_base_t : public hybrid_arc_base_t<message_base_t>, private message_link_t {
     virtual ~message_base_t() = default;
 
     /**
@@ -39,17 +105,45 @@ struct message_base_t : public arc_base_t<message_base_t> {
      */
     const void *type_index;
 
+    /** \brief dense message type id, used as index in address dispatch table */
+    std::uint32_t type_id;
+
+    /** \brief delivery lane of the message */
+    message_lane_t lane = message_lane_t::user;
+
+    /** \brief whether the message memory belongs to a message pool, see `make_pooled_message` */
+    bool pooled = false;
+
     /** \brief message destination address */
     address_ptr_t address;
 
+    /** \brief constructor which takes message type and its id and destination address */
+    inline message_base_t(const void *type_index_, std::uint32_t type_id_, const address_ptr_t &addr)
+        : type_index(type_index_), type_id{type_id_}, address{addr} {}
+
     /** \brief constructor which takes destination address */
     inline message_base_t(const void *type_index_, const address_ptr_t &addr)
-        : type_index(type_index_), address{addr} {}
-};
+        : message_base_t(type_index_, message_support::get_type_id(type_index_), addr) {}
 
-namespace message_support {
-ROTOR_API const void *register_type(const std::type_index &type_index) noexcept;
-}
+    /** \brief allocates message memory on heap */
+    static void *operator new(std::size_t size) { return ::operator new(size); }
+
+    /** \brief allocates message memory from the locality message pool */
+    ROTOR_API static void *operator new(std::size_t size, message_pool_t &pool);
+
+    /** \brief returns message memory to heap */
+    static void operator delete(void *ptr) noexcept { ::operator delete(ptr); }
+
+    /** \brief returns message memory back to the pool, if message construction throws */
+    ROTOR_API static void operator delete(void *ptr, message_pool_t &pool) noexcept;
+
+    /** \brief destroys unreferenced message and returns its memory to the pool or to heap */
+    ROTOR_API static void destroy(const message_base_t *message) noexcept;
+
+  private:
+    friend struct messages_queue_t;
+    friend struct inbound_messages_queue_t;
+};
 
 /** \struct message_t
  *  \brief the generic message meant to hold user-specific payload
@@ -63,28 +157,373 @@ template <typename T> struct message_t : public message_base_t {
     /** \brief forwards `args` for payload construction */
     template <typename... Args>
     message_t(const address_ptr_t &addr, Args &&...args)
-        : message_base_t{message_type, addr}, payload{std::forward<Args>(args)...} {}
+        : message_base_t{message_type, message_type_id, addr}, payload{std::forward<Args>(args)...} {
+        lane = message_lane_trait_t<T>::lane;
+    }
 
     /** \brief user-defined payload */
     T payload;
 
     /** \brief unique per-message-type pointer used for routing */
     static const void *message_type;
+
+    /** \brief dense per-message-type id used for dispatching */
+    static const std::uint32_t message_type_id;
 };
 
 template <typename T> const void *message_t<T>::message_type = message_support::register_type(typeid(message_t<T>));
 
+template <typename T>
+const std::uint32_t message_t<T>::message_type_id = message_support::register_type_id(typeid(message_t<T>));
+
 /** \brief intrusive pointer for message */
 using message_ptr_t = intrusive_ptr_t<message_base_t>;
 
-/** \brief structure to hold messages (intrusive pointers) */
-using messages_queue_t = std::deque<message_ptr_t>;
+/** \struct messages_queue_t
+ *  \brief intrusive FIFO of messages
+ *
+ * The queue owns a reference to each of queued messages, and it links
+ * them via the hook inside `message_base_t`, i.e. push and pop operations
+ * do not allocate and do not touch messages reference counters.
+ *
+ * When the queue is prioritized, messages of the control lane are
+ * kept separately and they are popped before any message of the user
+ * lane, i.e. the order is preserved within a lane only.
+ *
+ * A message might be in one queue at a time only.
+ *
+ */
+struct messages_queue_t {
+    messages_queue_t() noexcept = default;
+    messages_queue_t(const messages_queue_t &) = delete;
+
+    /** \brief takes all messages from the other queue */
+    messages_queue_t(messages_queue_t &&other) noexcept : prioritized{other.prioritized} { splice_back(other); }
+
+    ~messages_queue_t() { clear(); }
+
+    /** \brief appends message to the end of its lane */
+    inline void push_back(message_ptr_t message) noexcept {
+        auto ptr = message.detach();
+        assert(ptr && !next(ptr) && ptr != user.tail && ptr != control.tail && "message should not be queued twice");
+        lane_of(*ptr).append(ptr, ptr);
+        ++count;
+    }
+
+    /** \brief removes the first message (control lane first) from the queue and returns it */
+    inline message_ptr_t pop_front() noexcept {
+        auto &chain = control.head ? control : user;
+        assert(chain.head);
+        auto ptr = chain.head;
+        chain.head = next(ptr);
+        if (!chain.head) {
+            chain.tail = nullptr;
+        }
+        link(ptr, nullptr);
+        --count;
+        return message_ptr_t(ptr, false);
+    }
+
+    /** \brief removes the last message (user lane first) from the queue and returns it
+     *
+     * The operation has linear complexity, as the queue is singly-linked.
+     */
+    message_ptr_t pop_back() noexcept {
+        auto &chain = user.tail ? user : control;
+        assert(chain.tail);
+        auto ptr = chain.tail;
+        if (chain.head == chain.tail) {
+            chain.head = chain.tail = nullptr;
+        } else {
+            auto prev = chain.head;
+            while (next(prev) != chain.tail) {
+                prev = next(prev);
+            }
+            link(prev, nullptr);
+            chain.tail = prev;
+        }
+        --count;
+        return message_ptr_t(ptr, false);
+    }
+
+    /** \brief moves all messages of the other queue to the end of the queue lanes
+     *
+     * The operation is O(1), unless the queue is prioritized while the other one is not.
+     */
+    inline void splice_back(messages_queue_t &other) noexcept {
+        if (prioritized && !other.prioritized) {
+            if (other.user.head) {
+                splice_back(other.user.head, other.user.tail, other.count);
+                other.user = chain_t{};
+            }
+        } else {
+            (prioritized ? control : user).append(other.control);
+            user.append(other.user);
+            count += other.count;
+        }
+        other.count = 0;
+    }
+
+    /** \brief releases all queued messages */
+    void clear() noexcept {
+        while (!empty()) {
+            pop_front();
+        }
+    }
+
+    /** \brief turns on/off separate control lane
+     *
+     * When the priority is turned off, all pending control messages are
+     * moved in front of user messages.
+     */
+    void prioritize(bool value) noexcept {
+        if (!value && control.head) {
+            control.append(user);
+            user.append(control);
+        }
+        prioritized = value;
+    }
+
+    /** \brief returns `true` if control lane messages are delivered first */
+    inline bool is_prioritized() const noexcept { return prioritized; }
+
+    /** \brief returns reference to the first message of the (non-empty) queue */
+    inline message_base_t &front() const noexcept { return control.head ? *control.head : *user.head; }
+
+    /** \brief returns reference to the last message of the (non-empty) queue */
+    inline message_base_t &back() const noexcept { return user.tail ? *user.tail : *control.tail; }
+
+    /** \brief returns amount of queued messages */
+    inline std::size_t size() const noexcept { return count; }
+
+    /** \brief returns `true` if there are no queued messages */
+    inline bool empty() const noexcept { return !control.head && !user.head; }
+
+  private:
+    static inline message_base_t *next(message_base_t *message) noexcept {
+        auto next = message->next_link.load(std::memory_order_relaxed);
+        return static_cast<message_base_t *>(next);
+    }
+
+    static inline void link(message_base_t *message, message_base_t *next) noexcept {
+        message->next_link.store(next, std::memory_order_relaxed);
+    }
+
+    struct chain_t {
+        message_base_t *head = nullptr;
+        message_base_t *tail = nullptr;
+
+        inline void append(message_base_t *first, message_base_t *last) noexcept {
+            if (tail) {
+                link(tail, first);
+            } else {
+                head = first;
+            }
+            tail = last;
+        }
+
+        inline void append(chain_t &other) noexcept {
+            if (other.head) {
+                append(other.head, other.tail);
+                other.head = other.tail = nullptr;
+            }
+        }
+    };
+
+    inline chain_t &lane_of(const message_base_t &message) noexcept {
+        return (prioritized && message.lane == message_lane_t::control) ? control : user;
+    }
+
+    /* takes already linked chain of messages */
+    inline void splice_back(message_base_t *first, message_base_t *last, std::size_t amount) noexcept {
+        if (!prioritized) {
+            user.append(first, last);
+        } else {
+            auto message = first;
+            while (message) {
+                auto next_message = next(message);
+                link(message, nullptr);
+                lane_of(*message).append(message, message);
+                message = next_message;
+            }
+        }
+        count += amount;
+    }
+
+    chain_t control;
+    chain_t user;
+    std::size_t count = 0;
+    bool prioritized = false;
+
+    friend struct inbound_messages_queue_t;
+};
+
+/** \struct inbound_messages_queue_t
+ *  \brief unbounded intrusive multi-producer single-consumer queue of messages
+ *
+ * The queue is used for delivering messages from other localities (threads)
+ * into locality leader. Producers (any thread) push a message via single
+ * atomic exchange; the consumer (locality) takes all pending messages at
+ * once and splices them into the local `messages_queue_t`.
+ *
+ * The queue owns a reference to each of pushed messages.
+ *
+ * The implementation follows Dmitry Vyukov's intrusive MPSC queue.
+ *
+ */
+struct inbound_messages_queue_t {
+    inbound_messages_queue_t() noexcept : head{&stub}, tail{&stub} {}
+    inbound_messages_queue_t(const inbound_messages_queue_t &) = delete;
+    inbound_messages_queue_t(inbound_messages_queue_t &&) = delete;
+
+    ~inbound_messages_queue_t() {
+        message_base_t *message;
+        while (pop(message)) {
+            intrusive_ptr_release(message);
+        }
+    }
+
+    /** \brief appends message to the queue, takes ownership of the reference (thread-safe) */
+    inline void push(message_base_t *message) noexcept { push_link(message); }
+
+    /** \brief appends all messages of the local queue at once, i.e. via single atomic exchange (thread-safe)
+     *
+     * The control lane messages of the local queue are appended first.
+     */
+    void push(messages_queue_t &messages) noexcept {
+        auto &control = messages.control;
+        auto &user = messages.user;
+        if (!control.head && !user.head) {
+            return;
+        }
+        auto first = control.head ? control.head : user.head;
+        auto last = user.tail ? user.tail : control.tail;
+        if (control.head && user.head) {
+            messages_queue_t::link(control.tail, user.head);
+        }
+        control = user = messages_queue_t::chain_t{};
+        messages.count = 0;
+
+        last->next_link.store(nullptr, std::memory_order_relaxed);
+        auto prev = head.exchange(last, std::memory_order_acq_rel);
+        prev->next_link.store(first, std::memory_order_release);
+    }
+
+    /** \brief takes the oldest message with its reference, returns `false` if there are no one (consumer only)
+     *
+     * Might spuriously return `false` if a producer is in the middle of push.
+     */
+    bool pop(message_base_t *&message) noexcept {
+        auto first = tail;
+        auto next = first->next_link.load(std::memory_order_acquire);
+        if (first == &stub) {
+            if (!next) {
+                return false;
+            }
+            tail = first = next;
+            next = next->next_link.load(std::memory_order_acquire);
+        }
+        if (!next) {
+            if (first != head.load(std::memory_order_acquire)) {
+                return false;
+            }
+            push_link(&stub);
+            next = first->next_link.load(std::memory_order_acquire);
+            if (!next) {
+                return false;
+            }
+        }
+        tail = next;
+        first->next_link.store(nullptr, std::memory_order_relaxed);
+        message = static_cast<message_base_t *>(first);
+        return true;
+    }
+
+    /** \brief moves all pending messages to the end of the local queue, returns amount of moved messages
+     * (consumer only)
+     *
+     * Messages, which are in the middle of push, are left in the queue.
+     */
+    std::size_t drain(messages_queue_t &queue) noexcept {
+        std::size_t total = 0;
+        for (;;) {
+            auto first = tail;
+            auto next = first->next_link.load(std::memory_order_acquire);
+            if (first == &stub) {
+                if (!next) {
+                    break;
+                }
+                tail = first = next;
+                next = next->next_link.load(std::memory_order_acquire);
+            }
+
+            message_link_t *prev = nullptr;
+            auto last = first;
+            std::size_t count = 1;
+            while (next && next != &stub) {
+                prev = last;
+                last = next;
+                ++count;
+                next = next->next_link.load(std::memory_order_acquire);
+            }
+
+            if (!next && last == head.load(std::memory_order_acquire)) {
+                push_link(&stub);
+                next = last->next_link.load(std::memory_order_acquire);
+            }
+
+            bool complete = next != nullptr;
+            if (!complete) {
+                /* the last message is not linked yet with the next one, which is being pushed */
+                if (!prev) {
+                    break;
+                }
+                next = last;
+                last = prev;
+                --count;
+            }
+
+            tail = next;
+            last->next_link.store(nullptr, std::memory_order_relaxed);
+            queue.splice_back(static_cast<message_base_t *>(first), static_cast<message_base_t *>(last), count);
+            total += count;
+            if (!complete) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    /** \brief returns `true` if there are no pending messages (consumer only) */
+    inline bool empty() const noexcept {
+        return tail == &stub && !stub.next_link.load(std::memory_order_acquire);
+    }
+
+  private:
+    inline void push_link(message_link_t *link) noexcept {
+        link->next_link.store(nullptr, std::memory_order_relaxed);
+        auto prev = head.exchange(link, std::memory_order_acq_rel);
+        prev->next_link.store(link, std::memory_order_release);
+    }
+
+    std::atomic<message_link_t *> head;
+    message_link_t *tail;
+    message_link_t stub;
+};
 
 /** \brief constucts message by constructing it's payload; intrusive pointer for the message is returned */
 template <typename M, typename... Args> auto make_message(const address_ptr_t &addr, Args &&...args) -> message_ptr_t {
     return message_ptr_t{new message_t<M>(addr, std::forward<Args>(args)...)};
 }
 
+/** \brief constructs message in the memory of the pool (locality context only) */
+template <typename M, typename... Args>
+message_t<M> *make_pooled_message(message_pool_t &pool, const address_ptr_t &addr, Args &&...args) {
+    auto message = new (pool) message_t<M>(addr, std::forward<Args>(args)...);
+    message->pooled = true;
+    return message;
+}
+
 } // namespace rotor
 
 #if defined(_MSC_VER)
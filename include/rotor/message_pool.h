@@ -0,0 +1,147 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "arc.hpp"
+#include "rotor/export.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace rotor {
+
+/** \struct message_pool_stats_t
+ *  \brief message pool usage counters
+ */
+struct message_pool_stats_t {
+    /** \brief amount of allocations, served from previously released blocks */
+    std::size_t hits;
+
+    /** \brief amount of allocations, which required fresh memory (including oversized messages) */
+    std::size_t misses;
+
+    /** \brief amount of bytes currently owned by the pool (in-use and cached blocks) */
+    std::size_t bytes_held;
+};
+
+/** \struct message_pool_t
+ *  \brief size-class segregated free lists for messages of the same locality
+ *
+ * The pool is owned by locality leader (supervisor), and it is shared among
+ * all supervisors of the locality. Memory is allocated only in the locality
+ * context (i.e. in the thread of the event loop), while it can be released
+ * from any thread, as messages might cross locality boundaries.
+ *
+ * Each allocated block is prefixed by a small header, which refers back to
+ * the pool and its size class. The locality context explicitly enters the
+ * pool (see `context_t`) while it processes messages. The blocks, released
+ * within the entered context, are put into plain (non-atomic) free lists,
+ * i.e. the fast path does not use locked instructions. All other blocks
+ * (released in other localities, or outside of the message processing)
+ * are pushed into lock-free stack, which is drained on the next free-list
+ * miss. The thread identity is not used, as the locality context (e.g.
+ * asio strand) might be executed by different threads over time.
+ *
+ * Messages larger than `max_size` are allocated on heap.
+ *
+ * The pool is referenced by the supervisors of the locality only, not by
+ * its messages. When the last supervisor releases the pool, the cached
+ * memory is freed, and the pool is kept alive until all its messages
+ * (which might be still in queues of other localities) are released.
+ *
+ */
+struct ROTOR_API message_pool_t {
+    /** \brief the step between two consecutive size classes, in bytes */
+    static constexpr std::size_t granularity = 32;
+
+    /** \brief the amount of size classes */
+    static constexpr std::size_t size_classes = 32;
+
+    /** \brief the maximum block size (including header), which is served by the pool */
+    static constexpr std::size_t max_size = granularity * size_classes;
+
+    /** \struct context_t
+     *  \brief marks the current thread as running the locality context of the pool
+     *
+     * While the guard is alive, the messages of the pool are released in the
+     * current thread directly into the free lists. Guards might be nested
+     * (e.g. for different localities); the pool is kept alive by the guard.
+     */
+    struct ROTOR_API context_t {
+        /** \brief enters the context of the pool (no-op for null pool) */
+        explicit context_t(message_pool_t *pool) noexcept;
+        context_t(const context_t &) = delete;
+        context_t(context_t &&) = delete;
+
+        /** \brief leaves the context and restores the previously entered one */
+        ~context_t();
+
+      private:
+        intrusive_ptr_t<message_pool_t> pool;
+        message_pool_t *previous;
+    };
+
+    message_pool_t() noexcept;
+    message_pool_t(const message_pool_t &) = delete;
+    message_pool_t(message_pool_t &&) = delete;
+
+    /** \brief returns memory for a message of the given size (locality context only) */
+    void *allocate(std::size_t size);
+
+    /** \brief returns message memory into its pool or to heap (thread-safe) */
+    static void deallocate(void *ptr) noexcept;
+
+    /** \brief returns usage counters (locality context only) */
+    inline const message_pool_stats_t &get_stats() const noexcept { return stats; }
+
+    /** \brief returns the amount of references (supervisors) to the pool */
+    inline std::size_t use_count() const noexcept { return refs.load(std::memory_order_relaxed); }
+
+  private:
+    struct free_block_t;
+    using free_lists_t = std::array<free_block_t *, size_classes>;
+
+    ~message_pool_t();
+
+    void release(free_block_t *block) noexcept;
+    void drain_released() noexcept;
+    void orphan() noexcept;
+
+    friend void intrusive_ptr_add_ref(message_pool_t *pool) noexcept {
+        pool->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    friend void intrusive_ptr_release(message_pool_t *pool) noexcept {
+        if (pool->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            pool->orphan();
+        }
+    }
+
+    static free_block_t orphaned_mark;
+
+    free_lists_t free_lists;
+    std::atomic<free_block_t *> released;
+    std::atomic<std::size_t> refs;
+    std::atomic<std::size_t> orphaned_blocks;
+    std::size_t in_use;
+    message_pool_stats_t stats;
+};
+
+/** \brief intrusive pointer for message pool */
+using message_pool_ptr_t = intrusive_ptr_t<message_pool_t>;
+
+} // namespace rotor
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
@@ -13,6 +13,7 @@
 #include "subscription_point.h"
 #include "forward.hpp"
 #include "extended_error.h"
+#include <vector>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -137,6 +138,39 @@ struct handler_call_t {
     /** \brief The handler (intrusive pointer) on some external supervisor,
      * which can process the original message */
     handler_ptr_t handler;
+
+    /** \brief The subscription info on the handler side (liveness handle, optional) */
+    subscription_info_ptr_t subscription;
+};
+
+/** \struct multi_handler_call_t
+ *  \brief Message with this payload is forwarded to the handlers' supervisor for
+ * the delivery of the original message to all of its handlers at once.
+ *
+ * It is used instead of `handler_call_t`, when there are several handlers of
+ * the same external supervisor for the original message, i.e. the supervisor
+ * receives a single message, and fans it out locally.
+ *
+ */
+struct multi_handler_call_t {
+    /** \struct target_t
+     *  \brief handler and its subscription liveness handle */
+    struct target_t {
+        /** \brief The handler (intrusive pointer), which can process the original message */
+        handler_ptr_t handler;
+
+        /** \brief The subscription info on the handler side (liveness handle, optional) */
+        subscription_info_ptr_t subscription;
+    };
+
+    /** \brief alias for handlers list */
+    using targets_t = std::vector<target_t>;
+
+    /** \brief The original message (intrusive pointer) sent to an address */
+    message_ptr_t orig_message;
+
+    /** \brief The handlers of the same external supervisor, which can process the original message */
+    targets_t targets;
 };
 
 /** \struct external_subscription_t
@@ -152,6 +186,9 @@ struct handler_call_t {
 struct external_subscription_t {
     /** \brief subscription details */
     subscription_point_t point;
+
+    /** \brief the subscription info on the handler side (liveness handle) */
+    subscription_info_ptr_t origin;
 };
 
 /** \struct subscription_confirmation_t
@@ -311,6 +348,22 @@ struct unlink_request_t {
 
 } // namespace payload
 
+/* control-plane payloads, delivered via the control lane */
+template <> struct message_lane_trait_t<payload::initialize_actor_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::start_actor_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::create_actor_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::spawn_actor_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::shutdown_trigger_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::shutdown_request_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::external_subscription_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::subscription_confirmation_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::external_unsubscription_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::commit_unsubscription_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::unsubscription_confirmation_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::link_request_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::unlink_notify_t> : control_lane_trait_t {};
+template <> struct message_lane_trait_t<payload::unlink_request_t> : control_lane_trait_t {};
+
 /// namespace for rotor core messages (which just transform payloads)
 namespace message {
 
@@ -334,6 +387,9 @@ using commit_unsubscription_t = message_t<payload::commit_unsubscription_t>;
  */
 using handler_call_t = message_t<payload::handler_call_t>;
 
+/** \brief delivery of a message to several handlers of the same external supervisor */
+using multi_handler_call_t = message_t<payload::multi_handler_call_t>;
+
 // lifetime-related
 /** \brief actor initialization request */
 using init_request_t = request_traits_t<payload::initialize_actor_t>::request::message_t;
@@ -7,7 +7,9 @@
 //
 
 #include "plugin_base.h"
+#include <chrono>
 #include <string>
+#include <vector>
 
 #if !defined(NDEBUG) && !defined(ROTOR_DEBUG_DELIVERY)
 #define ROTOR_DO_DELIVERY_DEBUG 1
@@ -15,6 +17,8 @@
 
 namespace rotor::plugin {
 
+struct delivery_plugin_base_t;
+
 /** \struct local_delivery_t
  *
  * \brief basic local message delivery implementation
@@ -27,11 +31,14 @@ struct ROTOR_API local_delivery_t {
      *
      * - If the handler is local (i.e. it's actor belongs to the same supervisor),
      * - Otherwise the message is forwarded for delivery for the foreign supervisor,
-     * which owns the handler.
+     * which owns the handler. The forwarding is postponed via the `plugin`, so the
+     * wrapped messages share the same ordered batch with the messages sent directly
+     * to the addresses of the foreign supervisor.
      *
      */
 
-    static void delivery(message_ptr_t &message, const subscription_t::joint_handlers_t &local_recipients) noexcept;
+    static void delivery(message_ptr_t &message, const subscription_t::joint_handlers_t &local_recipients,
+                         delivery_plugin_base_t &plugin) noexcept;
 };
 
 /** \struct inspected_local_delivery_t
@@ -43,7 +50,8 @@ struct ROTOR_API inspected_local_delivery_t {
     static std::string identify(const message_base_t *message, int32_t threshold) noexcept;
 
     /** \brief delivers the message to the recipients, possbily dumping it to console */
-    static void delivery(message_ptr_t &message, const subscription_t::joint_handlers_t &local_recipients) noexcept;
+    static void delivery(message_ptr_t &message, const subscription_t::joint_handlers_t &local_recipients,
+                         delivery_plugin_base_t &plugin) noexcept;
 
     /** \brief dumps discarded message */
     static void discard(message_ptr_t &message) noexcept;
@@ -55,6 +63,19 @@ using default_local_delivery_t = local_delivery_t;
 using default_local_delivery_t = inspected_local_delivery_t;
 #endif
 
+/** \struct process_stats_t
+ *
+ * \brief counters of `process()` invocations, which have been interrupted
+ * due to processing budget exhaustion
+ */
+struct process_stats_t {
+    /** \brief amount of times the messages budget has been exhausted */
+    std::size_t budget_hits = 0;
+
+    /** \brief amount of times the time slice has been exhausted */
+    std::size_t slice_hits = 0;
+};
+
 /** \struct delivery_plugin_base_t
  *
  * \brief base implementation for messages delivery plugin
@@ -66,7 +87,56 @@ struct ROTOR_API delivery_plugin_base_t : public plugin_base_t {
     virtual size_t process() noexcept = 0;
     void activate(actor_base_t *actor) noexcept override;
 
+    /** \brief returns processing budget exhaustion counters */
+    inline const process_stats_t &get_process_stats() const noexcept { return stats; }
+
+    /** \brief postpones message forwarding to other locality till the end of `process()` invocation
+     *
+     * The messages are grouped per destination supervisor, preserving their order.
+     */
+    inline void forward(message_ptr_t message) noexcept {
+        auto destination = &message->address->supervisor;
+        for (auto &batch : outbound) {
+            if (batch.supervisor == destination) {
+                batch.messages.push_back(std::move(message));
+                return;
+            }
+        }
+        outbound.emplace_back(outbound_batch_t{destination, {}});
+        outbound.back().messages.push_back(std::move(message));
+    }
+
   protected:
+    /** \brief clock for time slice measurement */
+    using clock_t = std::chrono::steady_clock;
+
+    /** \brief the time slice is checked once per that amount of messages */
+    static constexpr std::size_t slice_check_period = 16;
+
+    /** \brief returns deadline of the current `process()` invocation, if time slice is set */
+    inline clock_t::time_point process_deadline() const noexcept {
+        return slice.count() ? clock_t::now() + slice : clock_t::time_point{};
+    }
+
+    /** \brief hands over the postponed messages to their destination supervisors, one batch per destination */
+    void flush_outbound() noexcept;
+
+    /** \brief checks whether the budget of the current `process()` invocation is exhausted */
+    inline bool budget_exhausted(std::size_t processed, const clock_t::time_point &deadline) noexcept {
+        if (!limited || !processed) {
+            return false;
+        }
+        if (budget && processed >= budget) {
+            ++stats.budget_hits;
+            return true;
+        }
+        if (slice.count() && (processed % slice_check_period == 0) && clock_t::now() >= deadline) {
+            ++stats.slice_hits;
+            return true;
+        }
+        return false;
+    }
+
     /** \brief non-owning raw pointer of supervisor's messages queue */
     messages_queue_t *queue = nullptr;
 
@@ -75,6 +145,31 @@ struct ROTOR_API delivery_plugin_base_t : public plugin_base_t {
 
     /** \brief non-owning raw pointer to supervisor's subscriptions map */
     subscription_t *subscription_map;
+
+    /** \brief max amount of messages per `process()` invocation (0 = unlimited) */
+    std::size_t budget = 0;
+
+    /** \brief max time per `process()` invocation (zero = unlimited) */
+    clock_t::duration slice{0};
+
+    /** \brief whether any of the limits is set */
+    bool limited = false;
+
+    /** \brief budget exhaustion counters */
+    process_stats_t stats;
+
+    /** \struct outbound_batch_t
+     * \brief messages to be forwarded to the same supervisor of other locality */
+    struct outbound_batch_t {
+        /** \brief destination supervisor */
+        supervisor_t *supervisor;
+
+        /** \brief the forwarded messages */
+        messages_queue_t messages;
+    };
+
+    /** \brief postponed messages for other localities, grouped per destination supervisor */
+    std::vector<outbound_batch_t> outbound;
 };
 
 /** \brief templated message delivery plugin, to allow local message delivery be customized */
@@ -27,6 +27,9 @@ struct ROTOR_API foreigners_support_plugin_t : public plugin_base_t {
     /** \brief handler for message call */
     virtual void on_call(message::handler_call_t &message) noexcept;
 
+    /** \brief handler for message call of several handlers at once */
+    virtual void on_multi_call(message::multi_handler_call_t &message) noexcept;
+
     /** \brief unsubscription message handler */
     virtual void on_unsubscription(message::commit_unsubscription_t &message) noexcept;
 
@@ -34,6 +37,9 @@ struct ROTOR_API foreigners_support_plugin_t : public plugin_base_t {
     virtual void on_subscription_external(message::external_subscription_t &message) noexcept;
 
   private:
+    void call(const handler_ptr_t &handler, const subscription_info_ptr_t &subscription,
+              message_ptr_t &orig_message) noexcept;
+
     subscription_container_t foreign_points;
 };
 
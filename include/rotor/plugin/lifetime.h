@@ -35,6 +35,9 @@ struct ROTOR_API lifetime_plugin_t : public plugin_base_t {
     /** \brief alias for unsubscription trigger (see below) */
     void unsubscribe(const handler_ptr_t &h, const address_ptr_t &addr) noexcept;
 
+    /** \brief alias for unsubscription trigger, the handler is looked up by its identity */
+    void unsubscribe(const handler_key_t &key, const address_ptr_t &addr) noexcept;
+
     /** \brief triggers unsubscription
      *
      * For internal subscriptions it answers with unsubscription
@@ -10,7 +10,12 @@
 #include "message.h"
 #include "extended_error.h"
 #include "forward.hpp"
+#include "timer_wheel.h"
+#include <memory>
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace rotor {
 
@@ -292,10 +297,120 @@ template <typename Request> struct wrapped_response_t {
     inline request_id_t request_id() const noexcept { return req->payload.id; }
 };
 
+/** \struct gathered_response_t
+ * \brief aggregated reply of scatter-gather request
+ *
+ * The responses are placed in the order of the request destinations; if there
+ * is no reply from a destination, the corresponding response is `nullptr`.
+ *
+ */
+template <typename Request> struct gathered_response_t {
+    /** \brief alias for original user-supplied request type */
+    using request_t = typename request_unwrapper_t<Request>::request_t;
+
+    /** \brief alias for response message of a single destination */
+    using response_message_t = message_t<wrapped_response_t<request_t>>;
+
+    /** \brief alias for intrusive pointer to response message of a single destination */
+    using response_message_ptr_t = intrusive_ptr_t<response_message_t>;
+
+    /** \brief responses of destinations (type) */
+    using responses_t = std::vector<response_message_ptr_t>;
+
+    /** \brief request id of the scatter-gather request */
+    request_id_t id;
+
+    /** \brief the error (timeout), if the required amount of replies has not been collected */
+    extended_error_ptr_t ee;
+
+    /** \brief responses of destinations */
+    responses_t responses;
+
+    /** \brief amount of the collected replies */
+    std::size_t replied;
+};
+
+/** \brief requests are delivered via the lane of the original payload */
+template <typename T, typename E> struct message_lane_trait_t<wrapped_request_t<T, E>> : message_lane_trait_t<T> {};
+
+/** \brief responses are delivered via the lane of the original request payload */
+template <typename Request>
+struct message_lane_trait_t<wrapped_response_t<Request>>
+    : message_lane_trait_t<typename wrapped_response_t<Request>::request_t> {};
+
+/** \brief request cancellations are delivered via the lane of the original request payload */
+template <typename T> struct message_lane_trait_t<cancelation_t<T>> : message_lane_trait_t<T> {};
+
+/** \brief aggregated replies are delivered via the lane of the original request payload */
+template <typename Request>
+struct message_lane_trait_t<gathered_response_t<Request>>
+    : message_lane_trait_t<typename gathered_response_t<Request>::request_t> {};
+
 /** \brief free function type, which produces error response to the original request */
 typedef message_ptr_t(error_producer_t)(const address_ptr_t &reply_to, message_base_t &msg,
                                         const extended_error_ptr_t &ec) noexcept;
 
+/** \brief free function type, which produces cancellation message for the original request */
+typedef message_ptr_t(cancel_producer_t)(message_base_t &msg) noexcept;
+
+/** \struct request_timer_t
+ * \brief request timeout node in the timing wheel of the locality leader */
+struct request_timer_t : timer_wheel_t::node_t {
+    /** \brief supervisor, which tracks the request */
+    supervisor_t *supervisor = nullptr;
+
+    /** \brief the request id */
+    request_id_t request_id = 0;
+};
+
+/** \struct gather_base_t
+ * \brief type-erased state of scatter-gather request
+ */
+struct gather_base_t {
+    virtual ~gather_base_t() = default;
+
+    /** \brief records the response; returns `true` if enough replies have been collected */
+    virtual bool collect(message_base_t &response) noexcept = 0;
+
+    /** \brief sends cancellations to the destinations, which have not replied yet */
+    virtual void cancel_pending(supervisor_t &sup) noexcept = 0;
+
+    /** \brief makes the aggregated reply from the collected responses */
+    virtual message_ptr_t make_reply(const address_ptr_t &reply_to, const extended_error_ptr_t &ee) noexcept = 0;
+};
+
+/** \brief owning pointer to scatter-gather request state */
+using gather_ptr_t = std::unique_ptr<gather_base_t>;
+
+/** \struct response_receiver_t
+ * \brief the receiver of the response, which bypasses the reply address (e.g. awaiting coroutine)
+ *
+ * The receiver is not owned by the request, i.e. it must outlive it.
+ */
+struct response_receiver_t {
+    virtual ~response_receiver_t() = default;
+
+    /** \brief the response (or the timeout error) to the request has arrived */
+    virtual void on_response(message_ptr_t message) noexcept = 0;
+
+    /** \brief the request has been cancelled (the requester shuts down), the response will not arrive */
+    virtual void on_abandon() noexcept = 0;
+};
+
+/** \struct request_flight_t
+ * \brief the requesters, which joined the identical request in flight (single-flight mode)
+ */
+struct request_flight_t {
+    /** \brief the key of the request in the flights of the locality leader */
+    std::size_t hash;
+
+    /** \brief request ids of the joined requesters */
+    std::vector<request_id_t> waiters;
+};
+
+/** \brief owning pointer to the single-flight request state */
+using request_flight_ptr_t = std::unique_ptr<request_flight_t>;
+
 /** \struct request_curry_t
  * \brief the recorded context, which is needed to produce error response to the original request */
 struct request_curry_t {
@@ -310,6 +425,24 @@ struct request_curry_t {
 
     /** \brief actor, on which behalf the original request has been made */
     actor_base_t *source;
+
+    /** \brief timeout node, when the request timeouts are tracked by timing wheel */
+    request_timer_t timer = {};
+
+    /** \brief the state of scatter-gather request (`nullptr` for regular request) */
+    gather_ptr_t gather = {};
+
+    /** \brief the free function, which produces cancellation, if the request is not replied (optional) */
+    cancel_producer_t *cancel_fn = nullptr;
+
+    /** \brief the joined requesters of the coalesced request (`nullptr` for regular request) */
+    request_flight_ptr_t flight = {};
+
+    /** \brief the direct receiver of the response (`nullptr` if the response goes to reply address) */
+    response_receiver_t *receiver = nullptr;
+
+    /** \brief the id of the coalesced request in flight, which the request has joined (`0` if not joined) */
+    request_id_t joined = 0;
 };
 
 /** \struct request_traits_t
@@ -360,6 +493,19 @@ template <typename R> struct request_traits_t {
         using message_t = rotor::message_t<cancel_payload_t>;
     };
 
+    /** \struct gather
+     * \brief scatter-gather request related types */
+    struct gather {
+        /** \brief aggregated reply payload */
+        using wrapped_t = gathered_response_t<request_t>;
+
+        /** \brief aggregated reply message */
+        using message_t = rotor::message_t<wrapped_t>;
+
+        /** \brief intrusive pointer type for aggregated reply message */
+        using message_ptr_t = intrusive_ptr_t<message_t>;
+    };
+
     /** \brief helper free function to produce error reply to the original request */
     static message_ptr_t make_error_response(const address_ptr_t &reply_to, message_base_t &message,
                                              const extended_error_ptr_t &ee) noexcept {
@@ -370,6 +516,71 @@ template <typename R> struct request_traits_t {
         auto raw_reply = new reply_message_t{reply_to, ee, req_ptr};
         return message_ptr_t{raw_reply};
     }
+
+    /** \brief helper free function to produce cancellation of the original request for its destination */
+    static message_ptr_t make_cancel(message_base_t &message) noexcept {
+        using cancel_message_t = typename cancel::message_t;
+        auto &request = static_cast<typename request::message_t &>(message);
+        auto &payload = request.payload;
+        auto raw_cancel = new cancel_message_t{request.address, payload.id, payload.origin};
+        return message_ptr_t{raw_cancel};
+    }
+};
+
+/** \struct inflight_requests_t
+ * \brief responder-side tracking of the requests in progress
+ *
+ * The request is tracked upon arrival and forgotten upon reply; the
+ * cancellation of the request (see `request_builder_t::auto_cancel`) forgets
+ * it too. So, a long-running processing can cheaply check, whether the
+ * request is still wanted by the requester, and abort otherwise.
+ *
+ * The requests are identified by the pair of their id and origin address.
+ *
+ */
+struct inflight_requests_t {
+    /** \brief starts tracking of the request */
+    inline void track(const request_base_t &request) noexcept {
+        requests.emplace(key_t{request.origin.get(), request.id});
+    }
+
+    /** \brief forgets the request (e.g. upon reply); returns `true` if it was tracked */
+    inline bool forget(const request_base_t &request) noexcept {
+        return requests.erase(key_t{request.origin.get(), request.id});
+    }
+
+    /** \brief forgets the cancelled request; returns `true` if it was tracked */
+    template <typename T> inline bool cancel(const cancelation_t<T> &cancelation) noexcept {
+        return requests.erase(key_t{cancelation.source.get(), cancelation.id});
+    }
+
+    /** \brief returns `true` if the request is neither replied nor cancelled */
+    inline bool wanted(const request_base_t &request) const noexcept {
+        return requests.count(key_t{request.origin.get(), request.id});
+    }
+
+    /** \brief returns the amount of the tracked requests */
+    inline std::size_t size() const noexcept { return requests.size(); }
+
+    /** \brief returns `true` if there are no tracked requests */
+    inline bool empty() const noexcept { return requests.empty(); }
+
+  private:
+    struct key_t {
+        const address_t *origin;
+        request_id_t id;
+        inline bool operator==(const key_t &other) const noexcept { return id == other.id && origin == other.origin; }
+    };
+
+    struct hash_t {
+        inline std::size_t operator()(const key_t &key) const noexcept {
+            auto seed = std::hash<const void *>()(key.origin);
+            auto value = std::hash<request_id_t>()(key.id);
+            return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+        }
+    };
+
+    std::unordered_set<key_t, hash_t> requests;
 };
 
 /** \struct request_builder_t
@@ -382,6 +593,55 @@ template <typename T> struct [[nodiscard]] request_builder_t {
     request_builder_t(supervisor_t &sup_, actor_base_t &actor_, const address_ptr_t &destination_,
                       const address_ptr_t &reply_to_, Args &&...args);
 
+    /** \brief sends cancellation to the destination, if the request is not replied
+     *
+     * The cancellation (`request_traits_t<T>::cancel::message_t`) is sent when the
+     * request times out or when the requesting actor shuts down.
+     *
+     */
+    request_builder_t &auto_cancel(bool value = true) noexcept {
+        do_auto_cancel = value;
+        return *this;
+    }
+
+    /** \brief coalesces the request with the identical one in flight (single-flight mode)
+     *
+     * If there is already coalesced request to the same destination with
+     * the equal payload, no new request is sent; the requester just joins
+     * the one in flight and gets the copy of its response. The joined
+     * request still has its own request id and its own timeout, i.e. it might
+     * time out earlier than the request in flight; it is cancelled, when
+     * the joined requester shuts down.
+     *
+     * If the request in flight is not replied (its requester shuts down or
+     * it times out), the flight is handed over to the first joined request,
+     * which is sent then to the destination.
+     *
+     * The request payload type should be hashable via `std::hash` and
+     * equality-comparable. The response payload should be wrapped into
+     * intrusive pointer (it is checked at compile time), so that the single
+     * response is shared among all joined requesters, i.e. it is not copied.
+     *
+     */
+    request_builder_t &coalesce(bool value = true) noexcept;
+
+    /** \brief delivers the response (or the timeout error) directly to the receiver
+     *
+     * The response is not re-addressed to the reply address, i.e. no
+     * subscription for the response is needed. The receiver is invoked
+     * from the supervisor context (upon response delivery or upon timeout
+     * timer triggering), after the request has been released. If the
+     * requesting actor shuts down, the receiver is notified via
+     * `on_abandon`.
+     *
+     * The request with the receiver is never coalesced with other requests.
+     *
+     */
+    request_builder_t &deliver_to(response_receiver_t &value) noexcept {
+        receiver = &value;
+        return *this;
+    }
+
     /** \brief actually dispatches requests and spawns timeout timer
      *
      * The request id of the dispatched request is returned
@@ -389,6 +649,14 @@ template <typename T> struct [[nodiscard]] request_builder_t {
      */
     request_id_t send(const pt::time_duration &send) noexcept;
 
+    /** \brief releases request slot, if the request has not been sent */
+    ~request_builder_t();
+
+    request_builder_t(const request_builder_t &) = delete;
+
+    /** \brief takes over the request slot of unsent request */
+    request_builder_t(request_builder_t &&other) noexcept;
+
   private:
     using traits_t = request_traits_t<T>;
     using request_message_t = typename traits_t::request::message_t;
@@ -399,14 +667,77 @@ template <typename T> struct [[nodiscard]] request_builder_t {
 
     supervisor_t &sup;
     actor_base_t &actor;
+    request_entry_t *entry;
     request_id_t request_id;
     const address_ptr_t &destination;
     const address_ptr_t &reply_to;
     bool do_install_handler;
+    bool do_auto_cancel = false;
     request_message_ptr_t req;
     address_ptr_t imaginary_address;
+    std::optional<std::size_t> flight_hash;
+    bool (*same_flight)(message_base_t &, message_base_t &) noexcept = nullptr;
+    response_receiver_t *receiver = nullptr;
+
+    static bool same_payload(message_base_t &lhs, message_base_t &rhs) noexcept;
+    bool join_flight() noexcept;
+
+    static address_ptr_t prepare_reply_address(supervisor_t &sup, actor_base_t &actor, bool &install) noexcept;
+    static void install_handler(supervisor_t &sup, actor_base_t &actor, const address_ptr_t &address) noexcept;
+
+    template <typename> friend struct scatter_builder_t;
+};
+
+/** \brief list of destination addresses */
+using addresses_t = std::vector<address_ptr_t>;
 
-    void install_handler() noexcept;
+/** \struct scatter_builder_t
+ * \brief builder of scatter-gather request
+ *
+ * The same request is sent to several destinations under a single request
+ * id and a single timeout. The responses are collected, and the aggregated
+ * reply (`request_traits_t<T>::gather::message_t`) is delivered once, when
+ * the required amount of replies (quorum) has been collected or when the
+ * timeout triggers. The destinations, which have not replied, get the
+ * cancellation message.
+ *
+ */
+template <typename T> struct [[nodiscard]] scatter_builder_t {
+    /** \brief constructs request messages for all destinations but still does not dispath them */
+    template <typename... Args>
+    scatter_builder_t(supervisor_t &sup_, actor_base_t &actor_, const addresses_t &destinations_,
+                      const address_ptr_t &reply_to_, const Args &...args);
+
+    /** \brief the amount of replies, enough for the aggregated reply (all destinations by default) */
+    scatter_builder_t &quorum(std::size_t value) noexcept;
+
+    /** \brief actually dispatches requests and spawns timeout timer
+     *
+     * The request id of the dispatched requests is returned
+     *
+     */
+    request_id_t send(const pt::time_duration &timeout) noexcept;
+
+    /** \brief releases request slot, if the request has not been sent */
+    ~scatter_builder_t();
+
+    scatter_builder_t(const scatter_builder_t &) = delete;
+
+  private:
+    using builder_t = request_builder_t<T>;
+    using traits_t = request_traits_t<T>;
+    using request_message_ptr_t = typename traits_t::request::message_ptr_t;
+    using requests_t = std::vector<request_message_ptr_t>;
+
+    supervisor_t &sup;
+    actor_base_t &actor;
+    request_entry_t *entry;
+    request_id_t request_id;
+    const address_ptr_t &reply_to;
+    bool do_install_handler;
+    std::size_t required;
+    requests_t requests;
+    address_ptr_t imaginary_address;
 };
 
 } // namespace rotor
@@ -0,0 +1,136 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "request.hpp"
+#include "rotor/export.h"
+#include <memory>
+#include <vector>
+
+namespace rotor {
+
+/** \struct request_entry_t
+ *  \brief slot of request table, i.e. the pending request context
+ */
+struct request_entry_t {
+    /** \brief the context of the pending request */
+    request_curry_t curry;
+
+    /** \brief the request id of the pending request, or the id of the next request in the slot */
+    request_id_t id = 0;
+
+    /** \brief previous request of the same actor */
+    request_entry_t *prev = nullptr;
+
+    /** \brief next request of the same actor (or next free slot) */
+    request_entry_t *next = nullptr;
+};
+
+/** \struct request_list_t
+ *  \brief intrusive list of the pending requests of an actor
+ */
+struct request_list_t {
+    /** \brief returns `true` if there are no pending requests */
+    inline bool empty() const noexcept { return head == nullptr; }
+
+    /** \brief returns the first pending request */
+    inline request_entry_t &front() noexcept { return *head; }
+
+    /** \brief links the request into the list */
+    inline void push(request_entry_t &entry) noexcept {
+        entry.prev = nullptr;
+        entry.next = head;
+        if (head) {
+            head->prev = &entry;
+        }
+        head = &entry;
+    }
+
+    /** \brief unlinks the request from the list */
+    inline void remove(request_entry_t &entry) noexcept {
+        if (entry.prev) {
+            entry.prev->next = entry.next;
+        } else {
+            head = entry.next;
+        }
+        if (entry.next) {
+            entry.next->prev = entry.prev;
+        }
+        entry.prev = entry.next = nullptr;
+    }
+
+  private:
+    request_entry_t *head = nullptr;
+};
+
+/** \struct request_table_t
+ *  \brief slab of pending requests of a locality
+ *
+ * The request id encodes the slot index (lower 32 bits) and the
+ * generation of the slot, which is incremented, when the slot is released.
+ * As `request_id_t` is 64-bit wide on all platforms, the slot index never
+ * spills into the generation bits.
+ * So, the lookup is just indexing and generation comparison, and the stale
+ * ids (e.g. of late responses) are never matched.
+ *
+ * The slots are allocated by chunks, i.e. they are never relocated.
+ *
+ * The ids with the highest bit set are never produced by the table; they
+ * are reserved for the ordinary timers.
+ *
+ */
+struct ROTOR_API request_table_t {
+    /** \brief amount of bits of request id, which address slot */
+    static constexpr unsigned slot_bits = 32;
+
+    static_assert(sizeof(request_id_t) * 8 == slot_bits * 2, "request id should have room for slot and generation");
+
+    /** \brief the highest bit of request id, which marks non-request (timer) ids */
+    static constexpr request_id_t timer_flag = request_id_t{1} << (sizeof(request_id_t) * 8 - 1);
+
+    request_table_t() noexcept;
+    request_table_t(const request_table_t &) = delete;
+    request_table_t &operator=(const request_table_t &) = delete;
+
+    /** \brief takes a free slot, its `id` is the new request id */
+    request_entry_t &acquire() noexcept;
+
+    /** \brief releases the slot, the request id becomes stale */
+    void release(request_entry_t &entry) noexcept;
+
+    /** \brief returns the pending request by id, or `nullptr` */
+    inline request_entry_t *find(request_id_t id) noexcept {
+        auto slot = id & slot_mask;
+        if (slot >= capacity) {
+            return nullptr;
+        }
+        auto &entry = chunks[slot >> chunk_bits][slot & chunk_mask];
+        return entry.id == id && entry.curry.source ? &entry : nullptr;
+    }
+
+    /** \brief returns the amount of the pending requests */
+    inline std::size_t size() const noexcept { return count; }
+
+    /** \brief returns `true` if there are no pending requests */
+    inline bool empty() const noexcept { return count == 0; }
+
+  private:
+    using chunk_ptr_t = std::unique_ptr<request_entry_t[]>;
+    using chunks_t = std::vector<chunk_ptr_t>;
+
+    static constexpr unsigned chunk_bits = 6;
+    static constexpr std::size_t chunk_size = std::size_t{1} << chunk_bits;
+    static constexpr std::size_t chunk_mask = chunk_size - 1;
+    static constexpr request_id_t slot_mask = (request_id_t{1} << slot_bits) - 1;
+
+    chunks_t chunks;
+    request_entry_t *free_list;
+    std::size_t capacity;
+    std::size_t count;
+};
+
+} // namespace rotor
@@ -20,6 +20,72 @@
 
 namespace rotor {
 
+/** \struct joint_handlers_t
+ *  \brief pair internal and external {@link handler_t}
+ *
+ * The unsubscribed handlers are nullified in place (and skipped during delivery),
+ * i.e. the positions of the remaining ones remain stable until the containers are
+ * compacted. That makes subscription and unsubscription constant-time.
+ *
+ */
+struct joint_handlers_t {
+    /** \brief vector of handler pointers */
+    using handlers_t = std::vector<handler_base_t *>;
+
+    /** \brief vector of subscription infos */
+    using infos_t = std::vector<subscription_info_t *>;
+
+    /** \struct entry_t
+     *  \brief internal handler along with its direct invoker
+     */
+    struct entry_t {
+        /** \brief direct invoker of the handler (no message type check, no virtual dispatch) */
+        handler_thunk_t thunk;
+
+        /** \brief the handler itself, `nullptr` if it is unsubscribed */
+        handler_base_t *handler;
+
+        /** \brief returns `true` if the handler is still subscribed */
+        inline explicit operator bool() const noexcept { return handler != nullptr; }
+    };
+
+    /** \brief vector of internal handlers with invokers */
+    using entries_t = std::vector<entry_t>;
+
+    /** \struct external_t
+     *  \brief subscription infos of the handlers of the same external supervisor
+     */
+    struct external_t {
+        /** \brief the supervisor, which processes the handlers */
+        supervisor_t *supervisor;
+
+        /** \brief subscription infos (which hold the handlers), might be `nullptr` */
+        infos_t infos;
+
+        /** \brief the amount of nullified infos */
+        std::size_t holes;
+    };
+
+    /** \brief vector of external handlers per supervisor */
+    using externals_t = std::vector<external_t>;
+
+    /** \brief internal handlers, i.e. those which belong to actors of the supervisor, might be nullified */
+    entries_t internal;
+
+    /** \brief subscription infos of internal handlers (in the same order) */
+    infos_t internal_infos;
+
+    /** \brief the amount of nullified internal handlers */
+    std::size_t internal_holes = 0;
+
+    /** \brief external handlers, i.e. those which belong to actors of other supervisors
+     *
+     * The subscription infos (which hold the handlers) are recorded to let the
+     * handler supervisor validate the forwarded calls.
+     */
+    externals_t external;
+};
+
 /** \struct subscription_t
  *  \brief Holds and classifies message handlers on behalf of supervisor
  *
@@ -31,18 +97,11 @@ struct ROTOR_API subscription_t {
     /** \brief alias for message type (i.e. stringized typeid) */
     using message_type_t = const void *;
 
-    /** \brief vector of handler pointers */
-    using handlers_t = std::vector<handler_base_t *>;
+    /** \brief internal and external handlers of an address for a message type */
+    using joint_handlers_t = rotor::joint_handlers_t;
 
-    /** \struct joint_handlers_t
-     *  \brief pair internal and external {@link handler_t}
-     */
-    struct joint_handlers_t {
-        /** \brief internal handlers, i.e. those which belong to actors of the supervisor */
-        handlers_t internal;
-        /** \brief external handlers, i.e. those which belong to actors of other supervisor */
-        handlers_t external;
-    };
+    /** \brief vector of handler pointers */
+    using handlers_t = joint_handlers_t::handlers_t;
 
     subscription_t() noexcept;
 
@@ -55,14 +114,22 @@ struct ROTOR_API subscription_t {
      */
     subscription_info_ptr_t materialize(const subscription_point_t &point) noexcept;
 
-    /** \brief sets new handler for the subscription point */
-    void update(subscription_point_t &point, handler_ptr_t &new_handler) noexcept;
+    /** \brief sets new handler for the subscription info */
+    void update(subscription_info_t &info, handler_ptr_t &new_handler) noexcept;
 
     /** \brief remove subscription_info from `internal_infos` and `mine_handlers` */
     void forget(const subscription_info_ptr_t &info) noexcept;
 
-    /** \brief returns list of all handlers for the message (internal and external) */
-    const joint_handlers_t *get_recipients(const message_base_t &message) const noexcept;
+    /** \brief returns list of all handlers for the message (internal and external)
+     *
+     * The lookup is performed in the dispatch table of the message destination
+     * address, indexed by message type id.
+     */
+    inline const joint_handlers_t *get_recipients(const message_base_t &message) const noexcept {
+        auto &table = message.address->dispatch_table;
+        auto type_id = message.type_id;
+        return type_id < table.size() ? table[type_id] : nullptr;
+    }
 
     /** \brief generic non-public fields accessor */
     template <typename T> auto &access() noexcept;
@@ -82,12 +149,15 @@ struct ROTOR_API subscription_t {
         }
     };
 
+    /* node-based container, i.e. joint handlers are pointer-stable */
     using addressed_handlers_t = boost::unordered_map<subscrption_key_t, joint_handlers_t, subscrption_key_hash_t>;
 
     using info_container_t = boost::unordered_map<address_ptr_t, std::vector<subscription_info_ptr_t>>;
     address_t *main_address;
     info_container_t internal_infos;
     addressed_handlers_t mine_handlers;
+
+    void set_dispatch(address_t &address, const void *message_type, const joint_handlers_t *handlers) noexcept;
 };
 
 } // namespace rotor
@@ -83,20 +83,23 @@ struct ROTOR_API subscription_point_t {
  *  \brief {@link subscription_point_t} with extended information (e.g. state)
  */
 struct ROTOR_API subscription_info_t : public arc_base_t<subscription_info_t>, subscription_point_t {
-    /** \brief subscription info state (subscribing, established, unsubscribing */
-    enum state_t { SUBSCRIBING, ESTABLISHED, UNSUBSCRIBING };
+    /** \brief subscription info state (subscribing, established, unsubscribing, unsubscribed) */
+    enum state_t { SUBSCRIBING, ESTABLISHED, UNSUBSCRIBING, UNSUBSCRIBED };
 
     /** \brief ctor from subscription point, internal address and internal handler and state */
     subscription_info_t(const subscription_point_t &point, bool internal_address_, bool internal_handler_,
                         state_t state_) noexcept
         : subscription_point_t{point}, internal_address{internal_address_},
-          internal_handler{internal_handler_}, state{state_} {}
+          internal_handler{internal_handler_}, state{state_}, info_slot{0}, handler_slot{0} {}
 
     /** \brief uses {@link subscription_point_t} comparison */
     inline bool operator==(const subscription_point_t &point) const noexcept {
         return (subscription_point_t &)(*this) == point;
     }
 
+    /** \brief returns `true` if the subscription is not removed yet */
+    inline bool is_live() const noexcept { return state != UNSUBSCRIBED; }
+
     /** \brief marks handler for blocking operations
      *
      * It is suitable for thread backend.
@@ -110,6 +113,13 @@ struct ROTOR_API subscription_info_t : public arc_base_t<subscription_info_t>, s
     /** \brief generic non-public methods accessor */
     template <typename T, typename... Args> auto access(Args... args) noexcept;
 
+    /** \brief the subscription info on the handler side (foreign subscriptions only)
+     *
+     * It is used by the foreign supervisor as a liveness handle of the subscription
+     * to validate forwarded handler calls in constant time.
+     */
+    intrusive_ptr_t<subscription_info_t> origin;
+
   private:
     void tag(const void *t) noexcept;
 
@@ -121,6 +131,12 @@ struct ROTOR_API subscription_info_t : public arc_base_t<subscription_info_t>, s
 
     /** \brief subscription state */
     state_t state;
+
+    /** \brief position of the info among the subscriptions of the (internal) address */
+    std::size_t info_slot;
+
+    /** \brief position of the handler among the handlers of the (internal) address for the message type */
+    std::size_t handler_slot;
 };
 
 /** \brief intrusive pointer for {@link subscription_info_t} */
@@ -132,6 +148,9 @@ using subscription_info_ptr_t = intrusive_ptr_t<subscription_info_t>;
 struct ROTOR_API subscription_container_t : public std::list<subscription_info_ptr_t> {
     /** \brief looks up for the subscription info pointer (returned as iterator) via the subscription point */
     iterator find(const subscription_point_t &point) noexcept;
+
+    /** \brief looks up for the subscription info pointer (returned as iterator) via handler identity and address */
+    iterator find(const handler_key_t &key, const address_ptr_t &address) noexcept;
 };
 
 } // namespace rotor
@@ -9,6 +9,7 @@
 #include "actor_base.h"
 #include "handler.h"
 #include "message.h"
+#include "message_pool.h"
 #include "messages.hpp"
 #include "subscription.h"
 #include "system_context.h"
@@ -16,13 +17,14 @@
 #include "address_mapping.h"
 #include "error_code.h"
 #include "spawner.h"
+#include "request_table.h"
+#include "timer_wheel.h"
 
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
-#include <boost/lockfree/queue.hpp>
-
 #if defined(_MSC_VER)
 #pragma warning(push)
 #pragma warning(disable : 4251)
@@ -128,8 +130,28 @@ struct ROTOR_API supervisor_t : public actor_base_t {
      * Tthe method returns amount of messages it enqueued for other locality leaders
      * (i.e. to be processed externally).
      *
+     * If the processing budget of the locality leader is exhausted, the
+     * remaining messages are left in the queue, and their processing is
+     * re-scheduled via `schedule_process`.
+     *
+     * If the message pool is enabled, the locality enters its context for
+     * the processing time, see `message_pool_t::context_t`.
+     *
      */
-    inline size_t do_process() noexcept { return locality_leader->delivery->process(); }
+    inline size_t do_process() noexcept {
+        auto leader = locality_leader;
+        message_pool_t::context_t pool_context{leader->message_pool.get()};
+        auto enqueued_messages = leader->delivery->process();
+        if (!leader->queue.empty()) {
+            leader->schedule_process();
+        }
+        return enqueued_messages;
+    }
+
+    /** \brief returns processing budget exhaustion counters of the locality */
+    inline const plugin::process_stats_t &get_process_stats() const noexcept {
+        return locality_leader->delivery->get_process_stats();
+    }
 
     /** \brief creates new {@link address_t} linked with the supervisor */
     virtual address_ptr_t make_address() noexcept;
@@ -175,13 +197,50 @@ struct ROTOR_API supervisor_t : public actor_base_t {
      */
     virtual void enqueue(message_ptr_t message) noexcept = 0;
 
+    /** \brief enqueues all messages of the queue thread safe way and triggers processing
+     *
+     * The same as `enqueue`, but the messages are handed over with a single
+     * wakeup of the supervisor. It is used by the locality leader to forward
+     * all messages for the supervisor, which have been collected during a
+     * single `do_process` invocation.
+     *
+     * The default implementation invokes `enqueue` for each message.
+     *
+     */
+    virtual void enqueue_batch(messages_queue_t &messages) noexcept;
+
     /** \brief puts a message into internal supevisor queue for further processing
      *
      * This is thread-unsafe method. The `enqueue` method should be used to put
      * a new message from external context in thread-safe way.
      *
      */
-    inline void put(message_ptr_t message) { locality_leader->queue.emplace_back(std::move(message)); }
+    inline void put(message_ptr_t message) { locality_leader->queue.push_back(std::move(message)); }
+
+    /** \brief constructs message by constructing it's payload in the locality context
+     *
+     * If the message pool is enabled for the locality, the message memory
+     * is taken from the pool, otherwise the message is allocated on heap
+     * (i.e. the same as `make_message`).
+     *
+     * If the hybrid reference counting is enabled for the locality, the
+     * message is created with non-atomic reference counter. It is switched
+     * to atomic mode by the supervisor as soon as the message is forwarded
+     * to other locality; however, rotor is not aware of message pointers,
+     * which are embedded into user payloads, or which are passed to other
+     * threads bypassing supervisors; in that case `share()` should be
+     * invoked on the message manually.
+     *
+     * This is thread-unsafe method, it should be invoked only from the
+     * supervisor (locality) context; however, the created message might be
+     * released in any thread.
+     *
+     */
+    template <typename M, typename... Args>
+    intrusive_ptr_t<message_t<M>> make_local_message(const address_ptr_t &addr, Args &&...args);
+
+    /** \brief returns message pool of the locality, if it is enabled */
+    inline message_pool_t *get_message_pool() const noexcept { return message_pool.get(); }
 
     /** \brief templated version of `subscribe_actor` */
     template <typename Handler> void subscribe(actor_base_t &actor, Handler &&handler) {
@@ -211,6 +270,18 @@ struct ROTOR_API supervisor_t : public actor_base_t {
                                     Args &&...args) noexcept {
         return request_builder_t<T>(*this, actor, dest_addr, reply_to, std::forward<Args>(args)...);
     }
+
+    /** \brief convenient method for scatter-gather request building
+     *
+     * The same request is constructed from `args` for each destination address.
+     * The aggregated reply will be delivered to `reply_to` address.
+     *
+     */
+    template <typename T, typename... Args>
+    scatter_builder_t<T> do_scatter(actor_base_t &actor, const addresses_t &dest_addrs, const address_ptr_t &reply_to,
+                                    const Args &...args) noexcept {
+        return scatter_builder_t<T>(*this, actor, dest_addrs, reply_to, args...);
+    }
     /**
      * \brief main subscription implementation
      *
@@ -248,23 +319,32 @@ struct ROTOR_API supervisor_t : public actor_base_t {
     template <typename T, typename... Args> auto access(Args... args) noexcept;
 
     /** \brief lock-free queue for inbound messages */
-    using inbound_queue_t = boost::lockfree::queue<message_base_t *>;
+    using inbound_queue_t = inbound_messages_queue_t;
 
   protected:
     /** \brief creates new address with respect to supervisor locality mark */
     virtual address_ptr_t instantiate_address(const void *locality) noexcept;
 
-    /** \brief timer to response with timeout procuder type */
-    using request_map_t = std::unordered_map<request_id_t, request_curry_t>;
-
     /** \brief invoked as timer callback; creates response or just clean up for previously set request */
     void on_request_trigger(request_id_t timer_id, bool cancelled) noexcept;
 
     /** \brief starts non-recurring timer (to be implemented in descendants) */
     virtual void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept = 0;
 
-    /** \brief cancels timer (to be implemented in descendants) */
-    virtual void do_cancel_timer(request_id_t timer_id) noexcept = 0;
+    /** \brief cancels timer (to be implemented in descendants)
+     *
+     * The handler is the same one, which has been passed to `do_start_timer`.
+     */
+    virtual void do_cancel_timer(timer_handler_base_t &handler) noexcept = 0;
+
+    /** \brief schedules further `do_process` invocation via event loop
+     *
+     * It is invoked on locality leader, when the processing budget is
+     * exhausted and there are unprocessed messages. The default implementation
+     * does nothing, i.e. the messages will be processed on the next `do_process`
+     * invocation.
+     */
+    virtual void schedule_process() noexcept;
 
     /** \brief intercepts message delivery for the tagged handler */
     virtual void intercept(message_ptr_t &message, const void *tag, const continuation_t &continuation) noexcept;
@@ -275,11 +355,14 @@ struct ROTOR_API supervisor_t : public actor_base_t {
     /** \brief queue of unprocessed messages */
     messages_queue_t queue;
 
-    /** \brief counter for request/timer ids */
+    /** \brief counter for timer ids */
     request_id_t last_req_id;
 
-    /** \brief timer to response with timeout procuder */
-    request_map_t request_map;
+    /** \brief pending requests of the locality (used on leader only) */
+    request_table_t request_table;
+
+    /** \brief coalesced requests in flight, keyed by payload hash (used on leader only) */
+    std::unordered_multimap<std::size_t, request_id_t> request_flights;
 
     /** \brief main subscription support class  */
     subscription_t subscription_map;
@@ -299,12 +382,39 @@ struct ROTOR_API supervisor_t : public actor_base_t {
     /** \brief inbound queue for external messages */
     inbound_queue_t inbound_queue;
 
-    /** \brief size of inbound queue */
+    /** \brief size of inbound queue
+     *
+     * \deprecated the inbound queue is unbounded intrusive list, the value is not used
+     */
     size_t inbound_queue_size;
 
     /** \brief how much time spend in active inbound queue polling */
     pt::time_duration poll_duration;
 
+    /** \brief max amount of messages, processed by a single `do_process` invocation (0 = unlimited) */
+    std::size_t process_budget;
+
+    /** \brief max time, spent by a single `do_process` invocation (zero = unlimited) */
+    pt::time_duration process_slice;
+
+    /** \brief messages memory pool of the locality (optional) */
+    message_pool_ptr_t message_pool;
+
+    /** \brief whether the messages memory pool should be created, if the supervisor leads locality */
+    bool use_message_pool;
+
+    /** \brief whether messages of the locality start with non-atomic reference counter */
+    bool hybrid_refcount;
+
+    /** \brief the tick of request timeouts wheel (zero = disabled) */
+    pt::time_duration request_wheel_tick;
+
+    /** \brief request timeouts wheel of the locality (owned by leader only) */
+    std::unique_ptr<timer_wheel_t> request_wheel;
+
+    /** \brief the precision of the timers (zero = exact) */
+    pt::time_duration timer_slack;
+
     /** \brief when flag is set, the supervisor will shut self down */
     const std::atomic_bool *shutdown_flag = nullptr;
 
@@ -325,23 +435,26 @@ struct ROTOR_API supervisor_t : public actor_base_t {
     address_mapping_t address_mapping;
 
     template <typename T> friend struct request_builder_t;
+    template <typename T> friend struct scatter_builder_t;
     template <typename Supervisor> friend struct actor_config_builder_t;
     friend struct plugin::delivery_plugin_base_t;
     friend struct actor_base_t;
     template <typename T> friend struct plugin::delivery_plugin_t;
 
     void discard_request(request_id_t request_id) noexcept;
+    void leave_flight(request_id_t request_id, request_id_t primary_id) noexcept;
+    void hand_over_flight(request_id_t request_id, request_flight_ptr_t &flight) noexcept;
+
+    void start_request_timer(request_id_t request_id, const pt::time_duration &timeout) noexcept;
+    void cancel_request_timer(request_id_t request_id) noexcept;
+    void on_wheel_tick(request_id_t timer_id, bool cancelled) noexcept;
+
+    request_id_t wheel_timer_id = 0;
 
     void on_shutdown_check_timer(request_id_t, bool cancelled) noexcept;
 
-    inline request_id_t next_request_id() noexcept {
-    AGAIN:
-        auto &map = locality_leader->request_map;
-        auto it = map.find(++locality_leader->last_req_id);
-        if (it != map.end()) {
-            goto AGAIN;
-        }
-        return locality_leader->last_req_id;
+    inline request_id_t next_timer_id() noexcept {
+        return request_table_t::timer_flag | ++locality_leader->last_req_id;
     }
 };
 
@@ -365,8 +478,23 @@ template <typename Supervisor> auto system_context_t::create_supervisor() {
         *this);
 }
 
+template <typename M, typename... Args>
+intrusive_ptr_t<message_t<M>> supervisor_t::make_local_message(const address_ptr_t &addr, Args &&...args) {
+    using final_message_t = message_t<M>;
+    final_message_t *message;
+    if (message_pool) {
+        message = make_pooled_message<M>(*message_pool, addr, std::forward<Args>(args)...);
+    } else {
+        message = new final_message_t(addr, std::forward<Args>(args)...);
+    }
+    if (hybrid_refcount) {
+        message->make_local();
+    }
+    return intrusive_ptr_t<final_message_t>{message};
+}
+
 template <typename M, typename... Args> void actor_base_t::send(const address_ptr_t &addr, Args &&...args) {
-    supervisor->put(make_message<M>(addr, std::forward<Args>(args)...));
+    supervisor->put(supervisor->template make_local_message<M>(addr, std::forward<Args>(args)...));
 }
 
 template <typename Delegate, typename Method>
@@ -380,16 +508,75 @@ void actor_base_t::start_timer(request_id_t request_id, const pt::time_duration
 
 template <typename Delegate, typename Method>
 request_id_t actor_base_t::start_timer(const pt::time_duration &interval, Delegate &delegate, Method method) noexcept {
-    auto request_id = supervisor->next_request_id();
+    auto request_id = supervisor->next_timer_id();
     start_timer(request_id, interval, delegate, std::forward<Method>(method));
     return request_id;
 }
 
-/** \brief wraps handler (pointer to member function) and actor address into intrusive pointer */
+template <typename Delegate, typename Method>
+request_id_t actor_base_t::start_periodic_timer(const pt::time_duration &interval, Delegate &delegate,
+                                                Method method) noexcept {
+    using final_handler_t = timer_handler_t<Delegate, Method>;
+    auto request_id = supervisor->next_timer_id();
+    auto handler = std::make_unique<final_handler_t>(this, request_id, &delegate, std::forward<Method>(method));
+    handler->period = std::chrono::microseconds{interval.total_microseconds()};
+    assert(handler->period.count() > 0 && "the period of the timer is positive");
+    handler->next = std::chrono::steady_clock::now() + handler->period;
+    supervisor->do_start_timer(interval, *handler);
+    timers_map.emplace(request_id, std::move(handler));
+    return request_id;
+}
+
+template <> inline auto &actor_base_t::access<details::to::handlers_cache>() noexcept { return handlers_cache; }
+template <> inline auto &actor_base_t::access<details::to::state>() noexcept { return state; }
+
+namespace details {
+
+/** \brief returns cached handler of the pointer-to-member function or creates (and caches) new one */
+template <typename Handler, typename Backend>
+handler_ptr_t intern_handler(actor_base_t &actor, Backend &backend, Handler &&handler) {
+    using final_handler_t = handler_t<Handler>;
+    auto &cache = actor.access<to::handlers_cache>();
+    using key_t = typename std::decay_t<decltype(cache)>::key_type;
+    auto key = key_t{final_handler_t::handler_type, static_cast<const void *>(&backend)};
+    auto range = cache.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (static_cast<final_handler_t &>(*it->second).handler == handler) {
+            return it->second;
+        }
+    }
+    handler_ptr_t wrapped_handler(new final_handler_t(backend, std::move(handler)));
+    if (actor.access<to::state>() < state_t::SHUTTING_DOWN) {
+        cache.emplace(key, wrapped_handler);
+    }
+    return wrapped_handler;
+}
+
+/** \brief returns user-supplied request payload, i.e. unwrapped from intrusive pointer, if needed */
+template <typename T, typename Message> const auto &raw_request_payload(const Message &message) noexcept {
+    using request_t = typename request_traits_t<T>::request_t;
+    auto &payload = message.payload.request_payload;
+    if constexpr (std::is_base_of_v<arc_base_t<request_t>, request_t>) {
+        return *payload;
+    } else {
+        return payload;
+    }
+}
+
+} // namespace details
+
+/** \brief wraps handler (pointer to member function) and actor address into intrusive pointer
+ *
+ * The handlers of pointer-to-member functions are interned per actor.
+ */
 template <typename Handler> handler_ptr_t wrap_handler(actor_base_t &actor, Handler &&handler) {
     using final_handler_t = handler_t<Handler>;
-    auto handler_raw = new final_handler_t(actor, std::move(handler));
-    return handler_ptr_t{handler_raw};
+    if constexpr (std::is_member_function_pointer_v<Handler>) {
+        return details::intern_handler(actor, actor, std::move(handler));
+    } else {
+        auto handler_raw = new final_handler_t(actor, std::move(handler));
+        return handler_ptr_t{handler_raw};
+    }
 }
 
 template <typename Handler> subscription_info_ptr_t actor_base_t::subscribe(Handler &&h) noexcept {
@@ -407,8 +594,7 @@ namespace plugin {
 
 template <typename Handler>
 subscription_info_ptr_t plugin_base_t::subscribe(Handler &&h, const address_ptr_t &addr) noexcept {
-    using final_handler_t = handler_t<Handler>;
-    handler_ptr_t wrapped_handler(new final_handler_t(*this, std::move(h)));
+    auto wrapped_handler = details::intern_handler(*actor, *this, std::move(h));
     auto info = actor->supervisor->subscribe(wrapped_handler, addr, actor, owner_tag_t::PLUGIN);
     own_subscriptions.emplace_back(info);
     return info;
@@ -438,30 +624,36 @@ subscription_info_ptr_t starter_plugin_t::subscribe_actor(Handler &&handler, con
 
 template <> inline size_t delivery_plugin_t<plugin::local_delivery_t>::process() noexcept {
     size_t enqueued_messages{0};
-    while (queue->size()) {
-        auto message = message_ptr_t(queue->front().detach(), false);
+    size_t processed{0};
+    auto deadline = process_deadline();
+    while (!queue->empty() && !budget_exhausted(processed++, deadline)) {
+        auto message = queue->pop_front();
         auto &dest = message->address;
-        queue->pop_front();
         auto internal = dest->same_locality(*address);
         if (internal) { /* subscriptions are handled by me */
             auto local_recipients = subscription_map->get_recipients(*message);
             if (local_recipients) {
-                plugin::local_delivery_t::delivery(message, *local_recipients);
+                plugin::local_delivery_t::delivery(message, *local_recipients, *this);
             }
         } else {
-            dest->supervisor.enqueue(std::move(message));
+            message->share();
+            forward(std::move(message));
             ++enqueued_messages;
         }
     }
+    if (!outbound.empty()) {
+        flush_outbound();
+    }
     return enqueued_messages;
 }
 
 template <> inline size_t delivery_plugin_t<plugin::inspected_local_delivery_t>::process() noexcept {
     size_t enqueued_messages{0};
-    while (queue->size()) {
-        auto message = message_ptr_t(queue->front().detach(), false);
+    size_t processed{0};
+    auto deadline = process_deadline();
+    while (!queue->empty() && !budget_exhausted(processed++, deadline)) {
+        auto message = queue->pop_front();
         auto &dest = message->address;
-        queue->pop_front();
         auto internal = dest->same_locality(*address);
         const subscription_t::joint_handlers_t *local_recipients = nullptr;
         bool delivery_attempt = false;
@@ -469,77 +661,203 @@ template <> inline size_t delivery_plugin_t<plugin::inspected_local_delivery_t>:
             local_recipients = subscription_map->get_recipients(*message);
             delivery_attempt = true;
         } else {
-            dest->supervisor.enqueue(std::move(message));
+            message->share();
+            forward(std::move(message));
             ++enqueued_messages;
         }
         if (local_recipients) {
-            plugin::inspected_local_delivery_t::delivery(message, *local_recipients);
+            plugin::inspected_local_delivery_t::delivery(message, *local_recipients, *this);
         } else {
             if (delivery_attempt) {
                 plugin::inspected_local_delivery_t::discard(message);
             }
         }
     }
+    if (!outbound.empty()) {
+        flush_outbound();
+    }
     return enqueued_messages;
 }
 
 } // namespace plugin
 
 template <typename Handler, typename Enabled> void actor_base_t::unsubscribe(Handler &&h) noexcept {
-    supervisor->unsubscribe_actor(address, wrap_handler(*this, std::move(h)));
+    unsubscribe(std::forward<Handler>(h), address);
 }
 
 template <typename Handler, typename Enabled>
 void actor_base_t::unsubscribe(Handler &&h, address_ptr_t &addr) noexcept {
-    supervisor->unsubscribe_actor(addr, wrap_handler(*this, std::move(h)));
+    using handler_type_t = std::decay_t<Handler>;
+    if constexpr (std::is_member_function_pointer_v<handler_type_t>) {
+        lifetime->unsubscribe(handler_key_t{handler_t<handler_type_t>::handler_type, this}, addr);
+    } else {
+        lifetime->unsubscribe(handler_key_t{h.handler_type, h.actor_ptr}, addr);
+    }
 }
 
 template <typename T>
 template <typename... Args>
 request_builder_t<T>::request_builder_t(supervisor_t &sup_, actor_base_t &actor_, const address_ptr_t &destination_,
                                         const address_ptr_t &reply_to_, Args &&...args)
-    : sup{sup_}, actor{actor_}, request_id{sup.next_request_id()}, destination{destination_}, reply_to{reply_to_},
-      do_install_handler{false} {
-    auto addr = sup.address_mapping.get_mapped_address(actor_, response_message_t::message_type);
-    if (addr) {
-        imaginary_address = addr;
-    } else {
-        // subscribe to imaginary address instead of real one because of
-        // 1. faster dispatching
-        // 2. need to distinguish between "timeout guarded responses" and "responses to own requests"
-        imaginary_address = sup.make_address();
-        do_install_handler = true;
-    }
-    req.reset(
-        new request_message_t{destination, request_id, imaginary_address, reply_to_, std::forward<Args>(args)...});
+    : sup{sup_}, actor{actor_}, entry{&sup.locality_leader->request_table.acquire()}, request_id{entry->id},
+      destination{destination_}, reply_to{reply_to_}, do_install_handler{false} {
+    imaginary_address = prepare_reply_address(sup, actor, do_install_handler);
+    using payload_t = typename request_message_t::payload_t;
+    req = sup.template make_local_message<payload_t>(destination, request_id, imaginary_address, reply_to_,
+                                                     std::forward<Args>(args)...);
+    // request is referenced from responses, which might be released in other localities
+    req->share();
 }
 
 template <typename T> request_id_t request_builder_t<T>::send(const pt::time_duration &timeout) noexcept {
+    // the joined request might take over the flight, so it needs the response handler too
     if (do_install_handler) {
-        install_handler();
+        install_handler(sup, actor, imaginary_address);
     }
     auto fn = &request_traits_t<T>::make_error_response;
-    sup.request_map.emplace(request_id, request_curry_t{fn, reply_to, req, &actor});
-    sup.put(req);
-    sup.start_timer(request_id, timeout, sup, &supervisor_t::on_request_trigger);
-    actor.active_requests.emplace(request_id);
+    entry->curry = request_curry_t{fn, reply_to, req, &actor};
+    if (do_auto_cancel) {
+        entry->curry.cancel_fn = &request_traits_t<T>::make_cancel;
+    }
+    entry->curry.receiver = receiver;
+    bool joined = false;
+    if (flight_hash && !receiver) {
+        joined = join_flight();
+        if (!joined) {
+            entry->curry.flight.reset(new request_flight_t{*flight_hash, {}});
+            sup.locality_leader->request_flights.emplace(*flight_hash, request_id);
+        }
+    }
+    actor.active_requests.push(*entry);
+    entry = nullptr;
+    if (!joined) {
+        sup.put(req);
+    }
+    sup.start_request_timer(request_id, timeout);
     return request_id;
 }
 
-template <typename T> void request_builder_t<T>::install_handler() noexcept {
+template <typename T> request_builder_t<T>::~request_builder_t() {
+    if (entry) {
+        sup.locality_leader->request_table.release(*entry);
+    }
+}
+
+template <typename T>
+request_builder_t<T>::request_builder_t(request_builder_t &&other) noexcept
+    : sup{other.sup}, actor{other.actor}, entry{other.entry}, request_id{other.request_id},
+      destination{other.destination}, reply_to{other.reply_to}, do_install_handler{other.do_install_handler},
+      do_auto_cancel{other.do_auto_cancel}, req{std::move(other.req)},
+      imaginary_address{std::move(other.imaginary_address)}, flight_hash{other.flight_hash},
+      same_flight{other.same_flight}, receiver{other.receiver} {
+    other.entry = nullptr;
+}
+
+template <typename T> request_builder_t<T> &request_builder_t<T>::coalesce(bool value) noexcept {
+    using wrapped_res_t = typename traits_t::response::wrapped_t;
+    static_assert(!std::is_same_v<typename wrapped_res_t::response_t, typename wrapped_res_t::unwrapped_response_t>,
+                  "the response of coalesced request should be wrapped into intrusive pointer");
+    if (!value) {
+        flight_hash.reset();
+        return *this;
+    }
+    auto &payload = details::raw_request_payload<T>(*req);
+    auto combine = [](std::size_t seed, std::size_t value) {
+        return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    };
+    auto hash = std::hash<std::decay_t<decltype(payload)>>()(payload);
+    hash = combine(hash, std::hash<const void *>()(destination.get()));
+    flight_hash = combine(hash, std::hash<const void *>()(request_message_t::message_type));
+    same_flight = &same_payload;
+    return *this;
+}
+
+template <typename T> bool request_builder_t<T>::same_payload(message_base_t &lhs, message_base_t &rhs) noexcept {
+    auto &lhs_payload = details::raw_request_payload<T>(static_cast<request_message_t &>(lhs));
+    return lhs_payload == details::raw_request_payload<T>(static_cast<request_message_t &>(rhs));
+}
+
+template <typename T> bool request_builder_t<T>::join_flight() noexcept {
+    auto leader = sup.locality_leader;
+    auto range = leader->request_flights.equal_range(*flight_hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto primary = leader->request_table.find(it->second);
+        assert(primary && primary->curry.flight);
+        auto &request = *primary->curry.request_message;
+        if (request.type_index != request_message_t::message_type || request.address != destination) {
+            continue;
+        }
+        if (same_flight(request, *req)) {
+            primary->curry.flight->waiters.emplace_back(request_id);
+            entry->curry.joined = it->second;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+address_ptr_t request_builder_t<T>::prepare_reply_address(supervisor_t &sup, actor_base_t &actor,
+                                                          bool &install) noexcept {
+    auto addr = sup.address_mapping.get_mapped_address(actor, response_message_t::message_type);
+    install = !addr;
+    if (!addr) {
+        // subscribe to imaginary address instead of real one because of
+        // 1. faster dispatching
+        // 2. need to distinguish between "timeout guarded responses" and "responses to own requests"
+        addr = sup.make_address();
+    }
+    return addr;
+}
+
+template <typename T>
+void request_builder_t<T>::install_handler(supervisor_t &sup, actor_base_t &actor,
+                                           const address_ptr_t &imaginary_address) noexcept {
     auto handler = lambda<response_message_t>([supervisor = &sup](response_message_t &msg) {
         auto request_id = msg.payload.request_id();
-        auto &request_map = supervisor->request_map;
-        auto it = request_map.find(request_id);
+        auto entry = supervisor->locality_leader->request_table.find(request_id);
 
         // if a response to request has arrived and no timer can be found
         // that means that either timeout timer already triggered
         // and error-message already delivered or response is not expected.
         // just silently drop it anyway
-        if (it != request_map.end()) {
-            auto &curry = it->second;
-            auto &orig_addr = curry.origin;
-            supervisor->template send<wrapped_res_t>(orig_addr, msg.payload);
+        if (entry && entry->curry.gather) {
+            auto &curry = entry->curry;
+            if (curry.gather->collect(msg)) {
+                supervisor->put(curry.gather->make_reply(curry.origin, {}));
+                supervisor->discard_request(request_id);
+            }
+        } else if (entry) {
+            if (auto &flight = entry->curry.flight; flight) {
+                // the joined requesters get own envelopes (with own request ids), while the
+                // response payload (intrusive pointer, see `coalesce`) is shared among them
+                auto waiters = std::move(flight->waiters);
+                flight->waiters.clear();
+                for (auto waiter_id : waiters) {
+                    auto waiter = supervisor->locality_leader->request_table.find(waiter_id);
+                    assert(waiter && waiter->curry.joined == request_id);
+                    auto &curry = waiter->curry;
+                    auto waiter_req = static_cast<request_message_t *>(curry.request_message.get());
+                    auto res = msg.payload.res;
+                    supervisor->template send<wrapped_res_t>(curry.origin, request_message_ptr_t{waiter_req},
+                                                             msg.payload.ee, std::move(res));
+                    curry.source->get_supervisor().discard_request(waiter_id);
+                }
+            }
+            if (auto receiver = entry->curry.receiver; receiver) {
+                supervisor->discard_request(request_id);
+                receiver->on_response(message_ptr_t(&msg));
+                return;
+            }
+            auto &orig_addr = entry->curry.origin;
+            if (msg.use_count() == 1) {
+                // the response is held by the current delivery only, so it can
+                // be re-addressed and re-queued as is, i.e. without payload copy
+                msg.address = orig_addr;
+                supervisor->put(message_ptr_t(&msg));
+            } else {
+                supervisor->template send<wrapped_res_t>(orig_addr, msg.payload);
+            }
             supervisor->discard_request(request_id);
         }
     });
@@ -548,6 +866,130 @@ template <typename T> void request_builder_t<T>::install_handler() noexcept {
     sup.address_mapping.set(actor, info);
 }
 
+namespace details {
+
+/** \brief collected responses of scatter-gather request */
+template <typename T> struct gather_t : gather_base_t {
+    /** \brief request/response types helper */
+    using traits_t = request_traits_t<T>;
+
+    /** \brief aggregated reply payload */
+    using reply_t = typename traits_t::gather::wrapped_t;
+
+    /** \brief pending requests, in the order of destinations (type) */
+    using requests_t = std::vector<typename traits_t::request::message_ptr_t>;
+
+    /** \brief request message to its position (leg) in `requests` */
+    using legs_t = std::unordered_map<const message_base_t *, std::size_t>;
+
+    /** \brief constructs empty (no replies yet) state */
+    gather_t(request_id_t id_, const requests_t &requests_, std::size_t required_) noexcept
+        : id{id_}, requests{requests_}, responses(requests_.size()), required{required_}, replied{0} {
+        legs.reserve(requests.size());
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            legs.emplace(requests[i].get(), i);
+        }
+    }
+
+    bool collect(message_base_t &message) noexcept override {
+        using response_message_t = typename traits_t::response::message_t;
+        auto &response = static_cast<response_message_t &>(message);
+        auto it = legs.find(response.payload.req.get());
+        if (it == legs.end() || !requests[it->second]) {
+            return false;
+        }
+        auto leg = it->second;
+        requests[leg].reset();
+        // the response is embedded into the reply, which might be delivered to other locality
+        response.share();
+        responses[leg].reset(&response);
+        return ++replied >= required;
+    }
+
+    void cancel_pending(supervisor_t &sup) noexcept override {
+        using payload_t = typename traits_t::cancel::cancel_payload_t;
+        for (auto &request : requests) {
+            if (request) {
+                sup.template send<payload_t>(request->address, id, request->payload.origin);
+                request.reset();
+            }
+        }
+    }
+
+    message_ptr_t make_reply(const address_ptr_t &reply_to, const extended_error_ptr_t &ee) noexcept override {
+        return make_message<reply_t>(reply_to, id, ee, std::move(responses), replied);
+    }
+
+    /** \brief the request id */
+    request_id_t id;
+
+    /** \brief requests, which have not been replied yet */
+    requests_t requests;
+
+    /** \brief positions of the requests, built once */
+    legs_t legs;
+
+    /** \brief collected responses */
+    typename reply_t::responses_t responses;
+
+    /** \brief amount of replies, enough for the aggregated reply */
+    std::size_t required;
+
+    /** \brief amount of collected replies */
+    std::size_t replied;
+};
+
+} // namespace details
+
+template <typename T>
+template <typename... Args>
+scatter_builder_t<T>::scatter_builder_t(supervisor_t &sup_, actor_base_t &actor_, const addresses_t &destinations_,
+                                        const address_ptr_t &reply_to_, const Args &...args)
+    : sup{sup_}, actor{actor_}, entry{&sup.locality_leader->request_table.acquire()}, request_id{entry->id},
+      reply_to{reply_to_}, do_install_handler{false}, required{destinations_.size()} {
+    imaginary_address = builder_t::prepare_reply_address(sup, actor, do_install_handler);
+    using payload_t = typename traits_t::request::message_t::payload_t;
+    requests.reserve(destinations_.size());
+    for (auto &destination : destinations_) {
+        auto req = sup.template make_local_message<payload_t>(destination, request_id, imaginary_address, reply_to_,
+                                                              args...);
+        // request is referenced from responses, which might be released in other localities
+        req->share();
+        requests.emplace_back(std::move(req));
+    }
+}
+
+template <typename T> scatter_builder_t<T> &scatter_builder_t<T>::quorum(std::size_t value) noexcept {
+    required = std::min(value, requests.size());
+    return *this;
+}
+
+template <typename T> request_id_t scatter_builder_t<T>::send(const pt::time_duration &timeout) noexcept {
+    if (do_install_handler) {
+        builder_t::install_handler(sup, actor, imaginary_address);
+    }
+    auto fn = &traits_t::make_error_response;
+    auto gather = new details::gather_t<T>(request_id, requests, required);
+    entry->curry = request_curry_t{fn, reply_to, {}, &actor, {}, gather_ptr_t(gather)};
+    actor.active_requests.push(*entry);
+    entry = nullptr;
+    for (auto &req : requests) {
+        sup.put(req);
+    }
+    sup.start_request_timer(request_id, timeout);
+    if (!required) {
+        sup.put(gather->make_reply(reply_to, {}));
+        sup.discard_request(request_id);
+    }
+    return request_id;
+}
+
+template <typename T> scatter_builder_t<T>::~scatter_builder_t() {
+    if (entry) {
+        sup.locality_leader->request_table.release(*entry);
+    }
+}
+
 /** \brief makes an reqest to the destination address with the message constructed from `args`
  *
  * The `reply_to` address is defaulted to actor's main address.1
@@ -573,6 +1015,18 @@ actor_base_t::request_via(const address_ptr_t &dest_addr, const address_ptr_t &r
     return supervisor->do_request<request_t>(*this, dest_addr, reply_addr, std::forward<Args>(args)...);
 }
 
+/** \brief makes the same request to each of the destination addresses
+ *
+ * The aggregated reply is delivered to actor's main address.
+ *
+ */
+template <typename Request, typename... Args>
+scatter_builder_t<typename request_wrapper_t<Request>::request_t>
+actor_base_t::scatter(const addresses_t &dest_addrs, const Args &...args) {
+    using request_t = typename request_wrapper_t<Request>::request_t;
+    return supervisor->do_scatter<request_t>(*this, dest_addrs, address, args...);
+}
+
 template <typename Request> auto actor_base_t::make_response(Request &message, const extended_error_ptr_t &ec) {
     using payload_t = typename Request::payload_t::request_t;
     using traits_t = request_traits_t<payload_t>;
@@ -584,7 +1038,9 @@ template <typename Request, typename... Args> auto actor_base_t::make_response(R
     using traits_t = request_traits_t<payload_t>;
     using response_t = typename traits_t::response::wrapped_t;
     using request_ptr_t = typename traits_t::request::message_ptr_t;
-    return make_message<response_t>(message.payload.reply_to, request_ptr_t{&message}, std::forward<Args>(args)...);
+    auto &addr = message.payload.reply_to;
+    return message_ptr_t{supervisor->template make_local_message<response_t>(addr, request_ptr_t{&message},
+                                                                             std::forward<Args>(args)...)};
 }
 
 template <typename Request, typename... Args> void actor_base_t::reply_to(Request &message, Args &&...args) {
@@ -42,7 +42,11 @@ struct supervisor_config_t : actor_config_t {
     address_ptr_t registry_address;
 
     /** \brief initial queue size for inbound messages. Makes sense only for
-     *  root/leader supervisor */
+     *  root/leader supervisor
+     *
+     * \deprecated the inbound queue is unbounded intrusive list, which does not
+     * need preallocation; the value is ignored
+     */
     size_t inbound_queue_size = 64;
 
     /**
@@ -56,6 +60,68 @@ struct supervisor_config_t : actor_config_t {
      */
     pt::time_duration poll_duration = pt::millisec{1};
 
+    /** \brief max amount of messages, processed by a single `do_process` invocation
+     *
+     * When the budget is exhausted, the supervisor re-schedules the processing
+     * of the remaining messages via its event loop, so I/O completions and timers
+     * are not starved by actors, which feed each other messages endlessly.
+     *
+     * Zero means unlimited. Makes sense only for root/leader supervisor.
+     */
+    std::size_t process_budget = 0;
+
+    /** \brief max time, spent by a single `do_process` invocation
+     *
+     * The same as `process_budget`, but the wall-clock time is limited.
+     * The clock is checked not on every message, so the slice might be
+     * slightly overrun. Zero means unlimited.
+     */
+    pt::time_duration process_slice = pt::time_duration{};
+
+    /** \brief whether messages, created in the locality context, should be
+     * allocated from per-locality memory pool.
+     *
+     * Makes sense only for root/leader supervisor; other supervisors of the
+     * locality share the pool of the leader.
+     */
+    bool message_pool = false;
+
+    /** \brief whether messages, created in the locality context, should use
+     * non-atomic reference counting until they are forwarded to other locality.
+     *
+     * Makes sense only for root/leader supervisor. Message pointers, embedded
+     * into user payloads, are not tracked, see `supervisor_t::make_local_message`.
+     */
+    bool hybrid_refcount = false;
+
+    /** \brief whether control-plane messages (actors initialization, shutdown,
+     * subscriptions, linking) should be processed before user messages.
+     *
+     * Makes sense only for root/leader supervisor, as it owns the queue
+     * of the locality. The order of messages is preserved within a lane only.
+     */
+    bool control_lane = false;
+
+    /** \brief the tick of timing wheel for request timeouts (zero = disabled)
+     *
+     * When it is set, request timeouts of the locality are tracked by a
+     * hierarchical timing wheel, driven by a single backend timer with the
+     * specified period, instead of a backend timer per request. The timeout
+     * precision becomes one tick.
+     *
+     * Makes sense only for root/leader supervisor.
+     */
+    pt::time_duration request_wheel_tick = pt::time_duration{};
+
+    /** \brief the precision of the timers of the supervisor (zero = exact)
+     *
+     * When it is set, the timer deadlines are rounded up to the multiple of
+     * the slack, i.e. the close deadlines share the same bucket and expire
+     * by a single wakeup of the event loop. The timers might trigger later
+     * up to the slack, but never earlier.
+     */
+    pt::time_duration timer_slack = pt::time_duration{};
+
     /** \brief pointer to atomic shutdown flag for polling (optional)
      *
      *  When it is set, supervisor will periodically check that the flag
@@ -103,7 +169,10 @@ template <typename Supervisor> struct supervisor_config_builder_t : actor_config
     }
 
     /** \brief initial queue size for inbound messages. Makes sense only for
-     *  root/leader supervisor */
+     *  root/leader supervisor
+     *
+     * \deprecated the value is ignored
+     */
     builder_t &&inbound_queue_size(size_t value) && {
         parent_t::config.inbound_queue_size = value;
         return std::move(*static_cast<builder_t *>(this));
@@ -115,6 +184,48 @@ template <typename Supervisor> struct supervisor_config_builder_t : actor_config
         return std::move(*static_cast<builder_t *>(this));
     }
 
+    /** \brief max amount of messages, processed by a single `do_process` invocation */
+    builder_t &&process_budget(std::size_t value) && {
+        parent_t::config.process_budget = value;
+        return std::move(*static_cast<builder_t *>(this));
+    }
+
+    /** \brief max time, spent by a single `do_process` invocation */
+    builder_t &&process_slice(const pt::time_duration &value) && {
+        parent_t::config.process_slice = value;
+        return std::move(*static_cast<builder_t *>(this));
+    }
+
+    /** \brief enables per-locality memory pool for messages */
+    builder_t &&message_pool(bool value = true) && {
+        parent_t::config.message_pool = value;
+        return std::move(*static_cast<builder_t *>(this));
+    }
+
+    /** \brief enables non-atomic reference counting for locality-confined messages */
+    builder_t &&hybrid_refcount(bool value = true) && {
+        parent_t::config.hybrid_refcount = value;
+        return std::move(*static_cast<builder_t *>(this));
+    }
+
+    /** \brief enables strict priority of control-plane messages over user messages */
+    builder_t &&control_lane(bool value = true) && {
+        parent_t::config.control_lane = value;
+        return std::move(*static_cast<builder_t *>(this));
+    }
+
+    /** \brief enables timing wheel with the specified tick for request timeouts */
+    builder_t &&request_wheel_tick(const pt::time_duration &value) && {
+        parent_t::config.request_wheel_tick = value;
+        return std::move(*static_cast<builder_t *>(this));
+    }
+
+    /** \brief sets the precision of timers, to let close deadlines expire together */
+    builder_t &&timer_slack(const pt::time_duration &value) && {
+        parent_t::config.timer_slack = value;
+        return std::move(*static_cast<builder_t *>(this));
+    }
+
     /** \brief atomic shutdown flag and the period for polling it
      *
      * The thread-safe way to shutdown supervisor even when compiled with
@@ -8,11 +8,12 @@
 
 #include "rotor/arc.hpp"
 #include "rotor/system_context.h"
-#include "rotor/timer_handler.hpp"
+#include "rotor/timer_queue.h"
 #include "rotor/thread/export.h"
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <condition_variable>
-#include <list>
 #include <mutex>
 #include <thread>
 
@@ -53,33 +54,35 @@ struct ROTOR_THREAD_API system_context_thread_t : public system_context_t {
     /** \brief checks for messages from external threads and fires expired timers */
     void check() noexcept;
 
-  protected:
-    /** \brief an alias for monotonic clock */
-    using clock_t = std::chrono::steady_clock;
-
-    /** \struct deadline_info_t
-     *  \brief struct to keep timer handlers
+    /** \brief returns the amount of timer wakeups, i.e. how many times expired timers have been fired
+     *
+     * The timers with close deadlines are fired by a single wakeup, if the
+     * supervisors have `timer_slack`; the counter can be sampled periodically
+     * (e.g. from other thread) to get wakeups per second.
      */
-    struct deadline_info_t {
-        /** \brief non-owning pointer to timer handler  */
-        timer_handler_base_t *handler;
-
-        /** \brief time point, after which the timer is considered expired */
-        clock_t::time_point deadline;
-    };
+    inline std::uint64_t get_timer_wakeups() const noexcept { return timer_wakeups.load(std::memory_order_relaxed); }
 
-    /** \brief ordered list of deadline infos (type) */
-    using list_t = std::list<deadline_info_t>;
+  protected:
+    /** \brief an alias for monotonic clock */
+    using clock_t = timer_queue_t::clock_t;
 
     /** \brief fires handlers for expired timers */
     void update_time() noexcept;
 
-    /** \brief start timer implementation */
-    void start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept;
+    /** \brief start timer implementation, the deadline is rounded up to the `slack` multiple */
+    void start_timer(const pt::time_duration &interval, timer_handler_base_t &handler,
+                     const pt::time_duration &slack) noexcept;
 
     /** \brief cancel timer implementation */
 
-    void cancel_timer(request_id_t timer_id) noexcept;
+    void cancel_timer(timer_handler_base_t &handler) noexcept;
+
+    /** \brief wakes up the context thread, if it is parked (sleeps on `cv`)
+     *
+     * It is invoked by the producers after pushing messages into the inbound
+     * queue; while the context thread is busy or polling, no lock is taken.
+     */
+    void wake() noexcept;
 
     /** \brief mutex for inbound queue */
     std::mutex mutex;
@@ -87,11 +90,17 @@ struct ROTOR_THREAD_API system_context_thread_t : public system_context_t {
     /** \brief cv for notifying about pushing messages into inbound queue */
     std::condition_variable cv;
 
+    /** \brief whether the context thread is about to sleep (or sleeps) on `cv` */
+    std::atomic_bool parked{false};
+
     /** \brief current time */
     clock_t::time_point now;
 
-    /** \brief ordered list of deadline infos */
-    list_t timer_nodes;
+    /** \brief armed timers, the earliest one is the first */
+    timer_queue_t timers;
+
+    /** \brief the amount of timer wakeups */
+    std::atomic<std::uint64_t> timer_wakeups{0};
 
     /** \brief whether the context is intercepting blocking (I/O) handler */
     bool intercepting = false;
@@ -7,6 +7,8 @@
 //
 
 #include "forward.hpp"
+#include <chrono>
+#include <cstddef>
 #include <memory>
 
 namespace rotor {
@@ -22,6 +24,18 @@ struct timer_handler_base_t {
     /** \brief timer identity (aka timer request id) */
     request_id_t request_id;
 
+    /** \brief the period of the recurring timer, zero for one-shot timer */
+    std::chrono::microseconds period{0};
+
+    /** \brief the scheduled time point of the next triggering of the recurring timer */
+    std::chrono::steady_clock::time_point next;
+
+    /** \brief the value of `heap_index` of the handler, which is not armed in a timer queue */
+    static constexpr std::size_t unlinked = static_cast<std::size_t>(-1);
+
+    /** \brief position of the handler in the backend timer queue (maintained by `timer_queue_t`) */
+    std::size_t heap_index = unlinked;
+
     /** \brief constructs timer handler from non-owning pointer to timer and timer request id */
     timer_handler_base_t(actor_base_t *owner_, request_id_t request_id_) noexcept
         : owner{owner_}, request_id{request_id_} {}
@@ -0,0 +1,92 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/timer_handler.hpp"
+#include "rotor/export.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace rotor {
+
+/** \struct timer_queue_t
+ *  \brief in-process queue of the armed timers of a backend, ordered by deadline
+ *
+ * The queue is a 4-ary min-heap, i.e. arming and cancellation are O(log n)
+ * and the earliest timer is always the first one. The position of a handler
+ * in the heap is stored in the handler itself, so neither arming nor
+ * cancellation allocate (except the heap growth).
+ * The timers with equal deadlines expire in the arming order.
+ *
+ * The backends keep all their timers in the queue and arm just a single
+ * native (event loop) timer for the earliest deadline.
+ *
+ */
+struct ROTOR_API timer_queue_t {
+    /** \brief an alias for monotonic clock */
+    using clock_t = std::chrono::steady_clock;
+
+    /** \brief non-owning pointer to timer handler */
+    using handler_ptr_t = timer_handler_base_t *;
+
+    /** \brief adds the timer handler, which expires after the deadline
+     *
+     * When the `slack` is positive, the deadline is rounded up to its multiple,
+     * i.e. the close deadlines are coalesced and expire together.
+     *
+     */
+    void push(timer_handler_base_t &handler, clock_t::time_point deadline,
+              const clock_t::duration &slack = clock_t::duration::zero()) noexcept;
+
+    /** \brief unlinks the timer handler, returns `false` if the handler is not armed in the queue */
+    bool remove(timer_handler_base_t &handler) noexcept;
+
+    /** \brief unlinks the earliest timer, if it is expired before `now`, and returns its handler
+     *
+     * `nullptr` is returned, when there are no expired timers.
+     *
+     */
+    handler_ptr_t pop_expired(const clock_t::time_point &now) noexcept;
+
+    /** \brief returns the deadline of the earliest timer; the queue must not be empty */
+    inline const clock_t::time_point &next_deadline() const noexcept { return nodes.front().deadline; }
+
+    /** \brief returns `true` if there are no armed timers */
+    inline bool empty() const noexcept { return nodes.empty(); }
+
+    /** \brief returns the amount of armed timers */
+    inline std::size_t size() const noexcept { return nodes.size(); }
+
+  private:
+    struct node_t {
+        handler_ptr_t handler;
+        clock_t::time_point deadline;
+        std::uint64_t sequence;
+    };
+    using nodes_t = std::vector<node_t>;
+
+    void place(std::size_t index, const node_t &node) noexcept;
+    void sift_up(std::size_t index) noexcept;
+    void sift_down(std::size_t index) noexcept;
+    void erase(std::size_t index) noexcept;
+
+    nodes_t nodes;
+    std::uint64_t sequence = 0;
+};
+
+} // namespace rotor
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
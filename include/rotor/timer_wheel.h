@@ -0,0 +1,111 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/export.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace rotor {
+
+/** \struct timer_wheel_t
+ *  \brief hierarchical hashed timing wheel with intrusive timer nodes
+ *
+ * The time is measured in ticks; the wheel does not depend on any clock,
+ * the owner advances it by one tick via `tick` method (usually from a single
+ * backend timer).
+ *
+ * There are `levels` of `slots` buckets each; the bucket of the level `N`
+ * covers `slots^N` ticks. The timers, which do not fit into the nearest level,
+ * are cascaded into lower levels, when the time comes. Arming and cancelling
+ * a timer is O(1) and does not allocate, as the nodes are embedded into
+ * the owner's structures.
+ *
+ * The timers, which are too far for the wheel, are parked in the last bucket
+ * and re-cascaded until they fit.
+ *
+ */
+struct ROTOR_API timer_wheel_t {
+    /** \brief amount of bits of the tick, addressed by one level */
+    static constexpr unsigned level_bits = 6;
+
+    /** \brief amount of buckets per level */
+    static constexpr std::size_t slots = std::size_t{1} << level_bits;
+
+    /** \brief amount of levels */
+    static constexpr unsigned levels = 4;
+
+    /** \struct node_t
+     *  \brief intrusive timer node (embedded into owner structure)
+     */
+    struct node_t {
+        /** \brief previous node in the bucket (`nullptr` when not armed) */
+        node_t *prev = nullptr;
+
+        /** \brief next node in the bucket (`nullptr` when not armed) */
+        node_t *next = nullptr;
+
+        /** \brief the tick, at which the timer expires */
+        std::uint64_t deadline = 0;
+
+        /** \brief returns `true` if the node is linked into the wheel */
+        inline bool armed() const noexcept { return prev != nullptr; }
+    };
+
+    timer_wheel_t() noexcept;
+    timer_wheel_t(const timer_wheel_t &) = delete;
+    timer_wheel_t &operator=(const timer_wheel_t &) = delete;
+
+    /** \brief links the node into the wheel, it will expire after the specified amount of ticks (at least 1) */
+    void arm(node_t &node, std::uint64_t ticks) noexcept;
+
+    /** \brief unlinks previously armed node */
+    void cancel(node_t &node) noexcept;
+
+    /** \brief advances the wheel by one tick, and invokes `fn(node_t &)` for each expired node
+     *
+     * The node is unlinked before invocation, so it is safe to release it or
+     * to arm it again. It is also safe to cancel other nodes from the callback.
+     */
+    template <typename Fn> void tick(Fn &&fn) noexcept {
+        advance();
+        auto &bucket = buckets[0][current & (slots - 1)];
+        if (bucket.next == &bucket) {
+            return;
+        }
+        node_t expired;
+        splice(bucket, expired);
+        while (expired.next != &expired) {
+            auto node = expired.next;
+            unlink(*node);
+            fn(*node);
+        }
+    }
+
+    /** \brief returns the current tick */
+    inline std::uint64_t now() const noexcept { return current; }
+
+    /** \brief returns the amount of armed nodes */
+    inline std::size_t size() const noexcept { return count; }
+
+    /** \brief returns `true` if there are no armed nodes */
+    inline bool empty() const noexcept { return count == 0; }
+
+  private:
+    void advance() noexcept;
+    void insert(node_t &node) noexcept;
+    void cascade(unsigned level) noexcept;
+    void unlink(node_t &node) noexcept;
+    static void splice(node_t &from, node_t &to) noexcept;
+
+    /* circular lists with sentinels */
+    node_t buckets[levels][slots];
+    std::uint64_t current;
+    std::size_t count;
+};
+
+} // namespace rotor
@@ -8,12 +8,12 @@
 
 #include "rotor/wx/export.h"
 #include "rotor/supervisor.h"
+#include "rotor/timer_queue.h"
 #include "rotor/wx/supervisor_config_wx.h"
 #include "rotor/wx/system_context_wx.h"
 #include <wx/event.h>
 #include <wx/timer.h>
 #include <memory>
-#include <unordered_map>
 
 namespace rotor {
 namespace wx {
@@ -53,6 +53,7 @@ struct ROTOR_WX_API supervisor_wx_t : public supervisor_t {
     void start() noexcept override;
     void shutdown() noexcept override;
     void enqueue(message_ptr_t message) noexcept override;
+    void enqueue_batch(messages_queue_t &messages) noexcept override;
     // void on_timer_trigger(request_id_t timer_id) noexcept override;
 
     /** \brief returns pointer to the wx system context */
@@ -60,41 +61,46 @@ struct ROTOR_WX_API supervisor_wx_t : public supervisor_t {
 
   protected:
     /** \struct timer_t
-     *  \brief timer structure, adoped for wx-supervisor needs.
+     *  \brief the native wx timer of the supervisor
      */
     struct ROTOR_WX_API timer_t : public wxTimer {
-        /** \brief alias for intrusive pointer for the supervisor */
-        using supervisor_ptr_t = intrusive_ptr_t<supervisor_wx_t>;
-
-        /** \brief non-owning pointer to timer handler */
-        timer_handler_base_t *handler;
-
-        /** \brief intrusive pointer to the supervisor */
-        supervisor_ptr_t sup;
-
         /** \brief constructs timer from wx supervisor */
-        timer_t(timer_handler_base_t *handler, supervisor_ptr_t &&sup_);
+        timer_t(supervisor_wx_t &sup_) noexcept;
 
-        /** \brief invokes `shutdown_timer_trigger` method if shutdown timer triggers*/
+        /** \brief fires expired timers of the supervisor */
         virtual void Notify() noexcept override;
+
+        /** \brief the owning supervisor */
+        supervisor_wx_t &sup;
     };
 
     friend struct timer_t;
 
     void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept override;
-    void do_cancel_timer(request_id_t timer_id) noexcept override;
+    void do_cancel_timer(timer_handler_base_t &handler) noexcept override;
+    void schedule_process() noexcept override;
 
     /** \brief unique pointer to timer */
     using timer_ptr_t = std::unique_ptr<timer_t>;
 
-    /** \brief timer id to timer pointer mapping type */
-    using timers_map_t = std::unordered_map<request_id_t, timer_ptr_t>;
-
     /** \brief non-owning pointer to the wx application (copied from config) */
     wxEvtHandler *handler;
 
-    /** \brief timer id to timer pointer mapping */
-    timers_map_t timers_map;
+    /** \brief armed timers of the supervisor, ordered by deadline */
+    timer_queue_t timers;
+
+    /** \brief the single native timer (created on demand), which is armed for the earliest deadline */
+    timer_ptr_t native_timer;
+
+    /** \brief the deadline, for which the native timer is armed */
+    timer_queue_t::clock_t::time_point native_deadline;
+
+    /** \brief whether the native timer is running (and holds the reference to the supervisor) */
+    bool native_armed = false;
+
+  private:
+    void arm_timer() noexcept;
+    void on_native_timer() noexcept;
 };
 
 } // namespace wx
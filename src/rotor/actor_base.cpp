@@ -87,6 +87,7 @@ void actor_base_t::on_start() noexcept { state = state_t::OPERATIONAL; }
 
 void actor_base_t::shutdown_start() noexcept {
     state = state_t::SHUTTING_DOWN;
+    handlers_cache.clear();
     if (!spawner_address) {
         if ((continuation_mask & ESCALATE_FALIURE) && shutdown_reason && shutdown_reason->root()->ec) {
             auto &sup = supervisor->get_address();
@@ -115,7 +116,7 @@ void actor_base_t::shutdown_finish() noexcept {
         cancel_timer(timers_map.begin()->first);
     }
     while (!active_requests.empty()) {
-        supervisor->do_cancel_timer(*active_requests.begin());
+        supervisor->cancel_request_timer(active_requests.front().id);
     }
     /*
     if (!deactivating_plugins.empty()) {
@@ -238,16 +239,38 @@ plugin_base_t *actor_base_t::get_plugin(const void *identity) const noexcept {
 }
 
 void actor_base_t::cancel_timer(request_id_t request_id) noexcept {
-    assert(timers_map.find(request_id) != timers_map.end() && "request does exist");
-    supervisor->do_cancel_timer(request_id);
+    auto it = timers_map.find(request_id);
+    assert(it != timers_map.end() && "request does exist");
+    supervisor->do_cancel_timer(*it->second);
 }
 
 void actor_base_t::on_timer_trigger(request_id_t request_id, bool cancelled) noexcept {
     auto it = timers_map.find(request_id);
     if (it != timers_map.end()) {
-        it->second->trigger(cancelled);
+        if (!cancelled && it->second->period.count()) {
+            rearm_timer(*it->second);
+            return;
+        }
+        // the handler might start new timers, so it is unlinked before the invocation
+        auto handler = std::move(it->second);
         timers_map.erase(it);
+        handler->trigger(cancelled);
+    }
+}
+
+void actor_base_t::rearm_timer(timer_handler_base_t &handler) noexcept {
+    using clock_t = std::chrono::steady_clock;
+    using time_units_t = std::chrono::microseconds;
+    // the next triggering is scheduled against the original schedule, the missed ones are skipped
+    auto now = clock_t::now();
+    handler.next += handler.period;
+    if (handler.next <= now) {
+        handler.next += handler.period * ((now - handler.next) / handler.period + 1);
     }
+    auto left = std::chrono::duration_cast<time_units_t>(handler.next - now);
+    // the timer is re-armed before the invocation, so it can be cancelled from the callback
+    supervisor->do_start_timer(pt::microseconds{left.count()}, handler);
+    handler.trigger(false);
 }
 
 void actor_base_t::assign_shutdown_reason(extended_error_ptr_t reason) noexcept {
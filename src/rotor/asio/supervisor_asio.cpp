@@ -6,6 +6,7 @@
 
 #include "rotor/asio/supervisor_asio.h"
 #include "rotor/asio/forwarder.hpp"
+#include <cassert>
 
 using namespace rotor::asio;
 using namespace rotor;
@@ -27,7 +28,7 @@ inline auto rotor::actor_base_t::access<to::on_timer_trigger, request_id_t, bool
 } // namespace rotor
 
 supervisor_asio_t::supervisor_asio_t(supervisor_config_asio_t &config_)
-    : supervisor_t{config_}, strand{config_.strand} {
+    : supervisor_t{config_}, strand{config_.strand}, native_timer{strand->context()} {
     if (config_.guard_context) {
         guard = std::make_unique<guard_t>(asio::make_work_guard(strand->context()));
     }
@@ -40,42 +41,65 @@ void supervisor_asio_t::start() noexcept { create_forwarder (&supervisor_asio_t:
 void supervisor_asio_t::shutdown() noexcept { create_forwarder (&supervisor_asio_t::invoke_shutdown)(); }
 
 void supervisor_asio_t::do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
-    auto timer = std::make_unique<supervisor_asio_t::timer_t>(&handler, strand->context());
-    timer->expires_from_now(interval);
+    using time_units_t = std::chrono::microseconds;
+    auto deadline = timer_queue_t::clock_t::now() + time_units_t{interval.total_microseconds()};
+    timers.push(handler, deadline, time_units_t{timer_slack.total_microseconds()});
+    if (!native_armed || timers.next_deadline() < native_deadline) {
+        arm_timer();
+    }
+}
+
+void supervisor_asio_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
+    auto removed = timers.remove(handler);
+    assert(removed && "timer has been found");
+    (void)removed;
+    auto actor_ptr = handler.owner;
+    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(handler.request_id, true);
+    // the native timer is left armed, unless there are no more timers, i.e. the early
+    // wakeup just re-arms it; that lets the io_context to finish, when there is no work
+    if (timers.empty() && native_armed) {
+        native_armed = false;
+        boost::system::error_code ec;
+        native_timer.cancel(ec);
+        // ignore the possible error, caused the case when timer is not cancelleable
+    }
+}
+
+void supervisor_asio_t::arm_timer() noexcept {
+    native_deadline = timers.next_deadline();
+    native_armed = true;
+    native_timer.expires_at(native_deadline);
 
     intrusive_ptr_t<supervisor_asio_t> self(this);
-    request_id_t timer_id = handler.request_id;
-    timer->async_wait([self = self, timer_id = timer_id](const boost::system::error_code &ec) {
-        auto &strand = self->get_strand();
+    native_timer.async_wait([self = std::move(self)](const boost::system::error_code &ec) mutable {
         if (!ec) {
-            asio::defer(strand, [self = self, timer_id = timer_id]() {
-                auto &sup = *self;
-                auto &timers_map = sup.timers_map;
-                auto it = timers_map.find(timer_id);
-                if (it != timers_map.end()) {
-                    auto actor_ptr = it->second->handler->owner;
-                    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
-                    timers_map.erase(timer_id);
-                    sup.do_process();
-                }
-            });
+            auto &strand = self->get_strand();
+            asio::defer(strand, [self = std::move(self)]() { self->on_native_timer(); });
         }
     });
-    timers_map.emplace(timer_id, std::move(timer));
 }
 
-void supervisor_asio_t::do_cancel_timer(request_id_t timer_id) noexcept {
-    auto &timer = timers_map.at(timer_id);
-    boost::system::error_code ec;
-    timer->cancel(ec);
-
-    auto &actor_ptr = timer->handler->owner;
-    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, true);
-    timers_map.erase(timer_id);
-    // ignore the possible error, caused the case when timer is not cancelleable
-    // if (ec) { ... }
+void supervisor_asio_t::on_native_timer() noexcept {
+    native_armed = false;
+    auto now = timer_queue_t::clock_t::now();
+    bool triggered = false;
+    // the handler might arm or cancel timers, so the timer is unlinked before the invocation
+    while (auto handler = timers.pop_expired(now)) {
+        auto actor_ptr = handler->owner;
+        auto timer_id = handler->request_id;
+        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
+        triggered = true;
+    }
+    if (!native_armed && !timers.empty()) {
+        arm_timer();
+    }
+    if (triggered) {
+        do_process();
+    }
 }
 
+void supervisor_asio_t::schedule_process() noexcept { create_forwarder (&supervisor_asio_t::do_process)(); }
+
 void supervisor_asio_t::enqueue(rotor::message_ptr_t message) noexcept {
     auto leader = static_cast<supervisor_asio_t *>(locality_leader);
     auto &inbound = leader->inbound_queue;
@@ -88,6 +112,18 @@ void supervisor_asio_t::enqueue(rotor::message_ptr_t message) noexcept {
     });
 }
 
+void supervisor_asio_t::enqueue_batch(messages_queue_t &messages) noexcept {
+    auto leader = static_cast<supervisor_asio_t *>(locality_leader);
+    auto &inbound = leader->inbound_queue;
+    inbound.push(messages);
+
+    auto actor_ptr = supervisor_ptr_t(this);
+    asio::defer(get_strand(), [actor = std::move(actor_ptr)]() mutable {
+        auto &sup = *actor;
+        sup.do_process();
+    });
+}
+
 void supervisor_asio_t::shutdown_finish() noexcept {
     if (guard)
         guard.reset();
@@ -108,21 +144,16 @@ void supervisor_asio_t::do_process() noexcept {
     auto &inbound = leader->inbound_queue;
     auto &queue = leader->queue;
     auto enqueued_messages{0};
-    message_base_t *ptr;
-    while (inbound.pop(ptr)) {
-        queue.emplace_back(ptr, false);
-    }
+    inbound.drain(queue);
     if (!queue.empty()) {
         enqueued_messages = supervisor_t::do_process();
     }
 
-    if (enqueued_messages) {
+    /* if the budget is exhausted, the processing is already re-scheduled */
+    if (enqueued_messages && queue.empty()) {
         auto deadline = clock_t::now() + time_units_t{poll_duration.total_microseconds()};
         while (clock_t::now() < deadline && queue.empty()) {
-            message_base_t *ptr;
-            while (inbound.pop(ptr)) {
-                queue.emplace_back(ptr, false);
-            }
+            inbound.drain(queue);
         }
         if (!queue.empty()) {
             supervisor_t::do_process();
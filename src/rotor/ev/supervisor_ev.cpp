@@ -5,6 +5,9 @@
 //
 
 #include "rotor/ev/supervisor_ev.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 
 using namespace rotor;
 using namespace rotor::ev;
@@ -13,7 +16,6 @@ namespace rotor::ev {
 namespace {
 namespace to {
 struct on_timer_trigger {};
-struct timers_map {};
 } // namespace to
 } // namespace
 } // namespace rotor::ev
@@ -25,8 +27,6 @@ inline auto rotor::actor_base_t::access<to::on_timer_trigger, request_id_t, bool
     on_timer_trigger(request_id, cancelled);
 }
 
-template <> inline auto &rotor::ev::supervisor_ev_t::access<to::timers_map>() noexcept { return timers_map; }
-
 } // namespace rotor
 
 void supervisor_ev_t::async_cb(struct ev_loop *, ev_async *w, int revents) noexcept {
@@ -36,29 +36,19 @@ void supervisor_ev_t::async_cb(struct ev_loop *, ev_async *w, int revents) noexc
     sup->on_async();
 }
 
-static void timer_cb(struct ev_loop *, ev_timer *w, int revents) noexcept {
+void supervisor_ev_t::timer_cb(struct ev_loop *, ev_timer *w, int revents) noexcept {
     assert(revents & EV_TIMER);
     (void)revents;
     auto *sup = static_cast<supervisor_ev_t *>(w->data);
-    auto timer = static_cast<supervisor_ev_t::timer_t *>(w);
-    auto timer_id = timer->handler->request_id;
-    auto &timers_map = sup->access<to::timers_map>();
-
-    try {
-        auto actor_ptr = timers_map.at(timer_id)->handler->owner;
-        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
-        timers_map.erase(timer_id);
-        sup->do_process();
-    } catch (std::out_of_range &ex) {
-        // no-op
-    }
-    intrusive_ptr_release(sup);
+    sup->on_native_timer();
 }
 
 supervisor_ev_t::supervisor_ev_t(supervisor_config_ev_t &config_)
     : supervisor_t{config_}, loop{config_.loop}, loop_ownership{config_.loop_ownership},
       poll_duration{static_cast<ev_tstamp>(supervisor_t::poll_duration.total_nanoseconds()) / 1000000000} {
     ev_async_init(&async_watcher, async_cb);
+    ev_timer_init(&native_timer, timer_cb, 0., 0.);
+    native_timer.data = this;
 }
 
 void supervisor_ev_t::do_initialize(system_context_t *ctx) noexcept {
@@ -67,6 +57,8 @@ void supervisor_ev_t::do_initialize(system_context_t *ctx) noexcept {
     supervisor_t::do_initialize(ctx);
 }
 
+void supervisor_ev_t::schedule_process() noexcept { ev_async_send(loop, &async_watcher); }
+
 void supervisor_ev_t::enqueue(rotor::message_ptr_t message) noexcept {
     auto leader = static_cast<supervisor_ev_t *>(locality_leader);
     auto &inbound = leader->inbound_queue;
@@ -74,6 +66,13 @@ void supervisor_ev_t::enqueue(rotor::message_ptr_t message) noexcept {
     ev_async_send(loop, &async_watcher);
 }
 
+void supervisor_ev_t::enqueue_batch(messages_queue_t &messages) noexcept {
+    auto leader = static_cast<supervisor_ev_t *>(locality_leader);
+    auto &inbound = leader->inbound_queue;
+    inbound.push(messages);
+    ev_async_send(loop, &async_watcher);
+}
+
 void supervisor_ev_t::start() noexcept { ev_async_send(loop, &async_watcher); }
 
 void supervisor_ev_t::shutdown_finish() noexcept {
@@ -90,31 +89,64 @@ void supervisor_ev_t::shutdown() noexcept {
 }
 
 void supervisor_ev_t::do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
-    auto timer = std::make_unique<timer_t>();
-    auto timer_ptr = timer.get();
-    ev_tstamp ev_timeout = static_cast<ev_tstamp>(interval.total_nanoseconds()) / 1000000000;
-    ev_timer_init(timer_ptr, timer_cb, ev_timeout, 0);
-    timer_ptr->handler = &handler;
-    timer_ptr->data = this;
-
-    ev_timer_start(loop, timer_ptr);
-    intrusive_ptr_add_ref(this);
-    timers_map.emplace(handler.request_id, std::move(timer));
-}
-
-void supervisor_ev_t::do_cancel_timer(request_id_t timer_id) noexcept {
-    try {
-        auto &timer = timers_map.at(timer_id);
-        ev_timer_stop(loop, timer.get());
-        auto actor_ptr = timer->handler->owner;
-        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, true);
-        timers_map.erase(timer_id);
+    using time_units_t = std::chrono::microseconds;
+    auto deadline = timer_queue_t::clock_t::now() + time_units_t{interval.total_microseconds()};
+    timers.push(handler, deadline, time_units_t{timer_slack.total_microseconds()});
+    if (!native_armed || timers.next_deadline() < native_deadline) {
+        arm_timer();
+    }
+}
+
+void supervisor_ev_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
+    auto removed = timers.remove(handler);
+    assert(removed && "timer has been found");
+    (void)removed;
+    auto actor_ptr = handler.owner;
+    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(handler.request_id, true);
+    // the native timer is left armed, unless there are no more timers, i.e. the early
+    // wakeup just re-arms it; that lets the loop to finish, when there is no work
+    if (timers.empty() && native_armed) {
+        native_armed = false;
+        ev_timer_stop(loop, &native_timer);
         intrusive_ptr_release(this);
-    } catch (std::out_of_range &ex) {
-        // no-op
     }
 }
 
+void supervisor_ev_t::arm_timer() noexcept {
+    using seconds_t = std::chrono::duration<ev_tstamp>;
+    native_deadline = timers.next_deadline();
+    auto left = std::max(seconds_t{native_deadline - timer_queue_t::clock_t::now()}, seconds_t{0});
+    if (native_armed) {
+        ev_timer_stop(loop, &native_timer);
+    } else {
+        native_armed = true;
+        intrusive_ptr_add_ref(this);
+    }
+    ev_timer_set(&native_timer, left.count(), 0.);
+    ev_timer_start(loop, &native_timer);
+}
+
+void supervisor_ev_t::on_native_timer() noexcept {
+    // the native timer is not active anymore, but the reference is still held
+    native_armed = false;
+    auto now = timer_queue_t::clock_t::now();
+    bool triggered = false;
+    // the handler might arm or cancel timers, so the timer is unlinked before the invocation
+    while (auto handler = timers.pop_expired(now)) {
+        auto actor_ptr = handler->owner;
+        auto timer_id = handler->request_id;
+        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
+        triggered = true;
+    }
+    if (!native_armed && !timers.empty()) {
+        arm_timer();
+    }
+    if (triggered) {
+        do_process();
+    }
+    intrusive_ptr_release(this);
+}
+
 void supervisor_ev_t::on_async() noexcept {
     move_inbound_queue();
     auto leader = static_cast<supervisor_ev_t *>(locality_leader);
@@ -124,7 +156,8 @@ void supervisor_ev_t::on_async() noexcept {
         enqueued_messages = do_process();
     }
 
-    if (enqueued_messages) {
+    /* if the budget is exhausted, the processing is already re-scheduled */
+    if (enqueued_messages && queue.empty()) {
         ev_now_update(loop);
         auto now = ev_now(loop);
         auto deadline = now + poll_duration;
@@ -149,9 +182,5 @@ supervisor_ev_t::~supervisor_ev_t() {
 void supervisor_ev_t::move_inbound_queue() noexcept {
     auto leader = static_cast<supervisor_ev_t *>(locality_leader);
     auto &inbound = leader->inbound_queue;
-    auto &queue = leader->queue;
-    message_base_t *ptr;
-    while (inbound.pop(ptr)) {
-        queue.emplace_back(ptr, false);
-    }
+    inbound.drain(leader->queue);
 }
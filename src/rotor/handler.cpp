@@ -31,8 +31,12 @@ struct continuation_impl_t final : continuation_t {
     message_ptr_t &message;
 };
 
-handler_base_t::handler_base_t(actor_base_t &actor, const void *handler_type_) noexcept
-    : handler_type{handler_type_}, actor_ptr{&actor} {
+static void call_virtually(handler_base_t &handler, message_ptr_t &message) noexcept {
+    handler.call(message);
+}
+
+handler_base_t::handler_base_t(actor_base_t &actor, const void *handler_type_, handler_thunk_t thunk_) noexcept
+    : handler_type{handler_type_}, actor_ptr{&actor}, thunk{thunk_ ? thunk_ : &call_virtually} {
     auto h1 = reinterpret_cast<std::size_t>(handler_type);
     auto h2 = reinterpret_cast<std::size_t>(&actor);
     precalc_hash = h1 ^ (h2 << 1);
@@ -47,16 +51,23 @@ handler_ptr_t handler_base_t::upgrade(const void *tag) noexcept {
 }
 
 handler_intercepted_t::handler_intercepted_t(handler_ptr_t backend_, const void *tag_) noexcept
-    : handler_base_t(*backend_->actor_ptr, backend_->handler_type), backend{std::move(backend_)}, tag{tag_} {}
+    : handler_base_t(*backend_->actor_ptr, backend_->handler_type, &invoke), backend{std::move(backend_)},
+      tag{tag_} {}
 
 void handler_intercepted_t::call(message_ptr_t &message) noexcept {
     if (select(message)) {
-        auto &sup = actor_ptr->get_supervisor();
-        continuation_impl_t continuation(*this, message);
-        sup.access<to::intercept, message_ptr_t &, const void *, const continuation_t &>(message, tag, continuation);
+        invoke(*this, message);
     }
 }
 
+void handler_intercepted_t::invoke(handler_base_t &self, message_ptr_t &message) noexcept {
+    auto &handler = static_cast<handler_intercepted_t &>(self);
+    auto &sup = handler.actor_ptr->get_supervisor();
+    continuation_impl_t continuation(handler, message);
+    sup.access<to::intercept, message_ptr_t &, const void *, const continuation_t &>(message, handler.tag,
+                                                                                     continuation);
+}
+
 bool handler_intercepted_t::select(message_ptr_t &message) noexcept { return backend->select(message); }
 
 void handler_intercepted_t::call_no_check(message_ptr_t &message) noexcept { return backend->call_no_check(message); }
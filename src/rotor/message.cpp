@@ -1,21 +1,39 @@
 #include "rotor/message.h"
 #include <unordered_map>
 
-using type_map_t = std::unordered_map<std::string_view, const void *>;
+namespace {
+struct type_info_t {
+    const void *message_type;
+    std::uint32_t type_id;
+};
 
-namespace rotor::message_support {
+using type_map_t = std::unordered_map<std::string_view, type_info_t>;
 
-const void *register_type(const std::type_index &type_index) noexcept {
+const type_info_t &register_info(std::string_view name) noexcept {
     static type_map_t type_map = {};
 
-    auto name = std::string_view(type_index.name());
     auto it = type_map.find(name);
     if (it != type_map.end()) {
         return it->second;
     }
-    auto ptr = static_cast<const void *>(type_index.name());
-    type_map[name] = ptr;
-    return ptr;
+    auto id = static_cast<std::uint32_t>(type_map.size());
+    auto ptr = static_cast<const void *>(name.data());
+    return type_map.emplace(name, type_info_t{ptr, id}).first->second;
+}
+} // namespace
+
+namespace rotor::message_support {
+
+const void *register_type(const std::type_index &type_index) noexcept {
+    return register_info(type_index.name()).message_type;
+}
+
+std::uint32_t register_type_id(const std::type_index &type_index) noexcept {
+    return register_info(type_index.name()).type_id;
+}
+
+std::uint32_t get_type_id(const void *message_type) noexcept {
+    return register_info(static_cast<const char *>(message_type)).type_id;
 }
 
 } // namespace rotor::message_support
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/message_pool.h"
+#include "rotor/message.h"
+#include <new>
+
+using namespace rotor;
+
+namespace {
+struct alignas(std::max_align_t) header_t {
+    message_pool_t *pool;
+    std::size_t size_class;
+};
+
+constexpr std::size_t header_size = sizeof(header_t);
+
+/* the pool, which locality context is currently executed by the thread */
+thread_local message_pool_t *current_pool = nullptr;
+
+static_assert(header_size % alignof(std::max_align_t) == 0, "message alignment should be preserved");
+} // namespace
+
+/* the next pointer of a released block overlaps with (already destroyed) message */
+struct message_pool_t::free_block_t {
+    header_t header;
+    free_block_t *next;
+};
+
+/* the head of released blocks stack of the pool, which has been released by its supervisors */
+message_pool_t::free_block_t message_pool_t::orphaned_mark{};
+
+message_pool_t::message_pool_t() noexcept
+    : free_lists{}, released{nullptr}, refs{0}, orphaned_blocks{0}, in_use{0},
+      stats{0, 0, 0} {}
+
+message_pool_t::~message_pool_t() {
+    for (auto block : free_lists) {
+        while (block) {
+            auto next = block->next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+}
+
+void *message_pool_t::allocate(std::size_t size) {
+    auto total = size + header_size;
+    if (total > max_size) {
+        ++stats.misses;
+        auto header = new (::operator new(total)) header_t{nullptr, 0};
+        return reinterpret_cast<char *>(header) + header_size;
+    }
+
+    auto size_class = (total - 1) / granularity;
+    auto &head = free_lists[size_class];
+    if (!head) {
+        drain_released();
+    }
+
+    free_block_t *block = head;
+    if (block) {
+        head = block->next;
+        ++stats.hits;
+    } else {
+        auto block_size = (size_class + 1) * granularity;
+        block = static_cast<free_block_t *>(::operator new(block_size));
+        stats.bytes_held += block_size;
+        ++stats.misses;
+    }
+    ++in_use;
+    auto header = new (block) header_t{this, size_class};
+    return reinterpret_cast<char *>(header) + header_size;
+}
+
+void message_pool_t::deallocate(void *ptr) noexcept {
+    auto header = reinterpret_cast<header_t *>(static_cast<char *>(ptr) - header_size);
+    auto pool = header->pool;
+    if (!pool) {
+        ::operator delete(header);
+    } else {
+        pool->release(reinterpret_cast<free_block_t *>(header));
+    }
+}
+
+void message_pool_t::release(free_block_t *block) noexcept {
+    if (current_pool == this) {
+        auto &head = free_lists[block->header.size_class];
+        block->next = head;
+        head = block;
+        --in_use;
+        return;
+    }
+
+    auto head = released.load(std::memory_order_acquire);
+    do {
+        if (head == &orphaned_mark) {
+            ::operator delete(block);
+            if (orphaned_blocks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+            return;
+        }
+        block->next = head;
+    } while (!released.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_acquire));
+}
+
+void message_pool_t::drain_released() noexcept {
+    auto block = released.exchange(nullptr, std::memory_order_acquire);
+    while (block) {
+        auto next = block->next;
+        auto &head = free_lists[block->header.size_class];
+        block->next = head;
+        head = block;
+        --in_use;
+        block = next;
+    }
+}
+
+void message_pool_t::orphan() noexcept {
+    /* no context holds the pool, so all further releases go via released stack */
+    orphaned_blocks.store(in_use + 1, std::memory_order_relaxed);
+
+    std::size_t freed = 1;
+    auto block = released.exchange(&orphaned_mark, std::memory_order_acq_rel);
+    while (block) {
+        auto next = block->next;
+        ::operator delete(block);
+        ++freed;
+        block = next;
+    }
+    if (orphaned_blocks.fetch_sub(freed, std::memory_order_acq_rel) == freed) {
+        delete this;
+    }
+}
+
+message_pool_t::context_t::context_t(message_pool_t *pool_) noexcept : pool{pool_}, previous{current_pool} {
+    if (pool_) {
+        current_pool = pool_;
+    }
+}
+
+message_pool_t::context_t::~context_t() { current_pool = previous; }
+
+void *message_base_t::operator new(std::size_t size, message_pool_t &pool) { return pool.allocate(size); }
+
+void message_base_t::operator delete(void *ptr, message_pool_t &) noexcept { message_pool_t::deallocate(ptr); }
+
+void message_base_t::destroy(const message_base_t *message) noexcept {
+    if (!message->pooled) {
+        delete message;
+    } else {
+        auto ptr = const_cast<message_base_t *>(message);
+        ptr->~message_base_t();
+        message_pool_t::deallocate(ptr);
+    }
+}
@@ -8,6 +8,7 @@
 #include "rotor/supervisor.h"
 #include "rotor/messages.hpp"
 #include <boost/core/demangle.hpp>
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
 #include <sstream>
@@ -28,21 +29,51 @@ void delivery_plugin_base_t::activate(actor_base_t *actor_) noexcept {
     auto sup = static_cast<supervisor_t *>(actor_);
     queue = &sup->locality_leader->queue;
     address = sup->address.get();
+    budget = sup->process_budget;
+    slice = std::chrono::microseconds{sup->process_slice.total_microseconds()};
+    limited = budget || slice.count();
     subscription_map = &sup->subscription_map;
     subscription_map->access<to::main_address>() = address;
     sup->delivery = this;
 }
 
-void local_delivery_t::delivery(message_ptr_t &message,
-                                const subscription_t::joint_handlers_t &local_recipients) noexcept {
-    for (auto &handler : local_recipients.external) {
-        auto &sup = handler->actor_ptr->get_supervisor();
-        auto &address = sup.get_address();
-        auto wrapped_message = make_message<payload::handler_call_t>(address, message, handler);
-        sup.enqueue(std::move(wrapped_message));
+void delivery_plugin_base_t::flush_outbound() noexcept {
+    for (auto &batch : outbound) {
+        batch.supervisor->enqueue_batch(batch.messages);
     }
-    for (auto &handler : local_recipients.internal) {
-        handler->call(message);
+    outbound.clear();
+}
+
+void local_delivery_t::delivery(message_ptr_t &message, const subscription_t::joint_handlers_t &local_recipients,
+                                delivery_plugin_base_t &plugin) noexcept {
+    if (!local_recipients.external.empty()) {
+        message->share();
+    }
+    /* each external supervisor gets a single message, the unsubscribed handlers are skipped */
+    for (auto &external : local_recipients.external) {
+        auto &infos = external.infos;
+        auto &address = external.supervisor->get_address();
+        message_ptr_t wrapped_message;
+        if (infos.size() - external.holes == 1) {
+            auto &info = **std::find_if(infos.begin(), infos.end(), [](auto &item) { return item != nullptr; });
+            wrapped_message = make_message<payload::handler_call_t>(address, message, info.handler, info.origin);
+        } else {
+            payload::multi_handler_call_t::targets_t targets;
+            targets.reserve(infos.size() - external.holes);
+            for (auto info : infos) {
+                if (info) {
+                    targets.emplace_back(payload::multi_handler_call_t::target_t{info->handler, info->origin});
+                }
+            }
+            wrapped_message = make_message<payload::multi_handler_call_t>(address, message, std::move(targets));
+        }
+        wrapped_message->lane = message->lane;
+        plugin.forward(std::move(wrapped_message));
+    }
+    for (auto &entry : local_recipients.internal) {
+        if (entry.handler) {
+            entry.thunk(*entry.handler, message);
+        }
     }
 }
 
@@ -175,9 +206,10 @@ static void dump_message(const char *prefix, const message_ptr_t &message) noexc
 }
 
 void inspected_local_delivery_t::delivery(message_ptr_t &message,
-                                          const subscription_t::joint_handlers_t &local_recipients) noexcept {
+                                          const subscription_t::joint_handlers_t &local_recipients,
+                                          delivery_plugin_base_t &plugin) noexcept {
     dump_message(">> ", message);
-    local_delivery_t::delivery(message, local_recipients);
+    local_delivery_t::delivery(message, local_recipients, plugin);
 }
 
 void inspected_local_delivery_t::discard(message_ptr_t &message) noexcept { dump_message("<DISCARDED> ", message); }
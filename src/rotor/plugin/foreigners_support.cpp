@@ -33,6 +33,7 @@ void foreigners_support_plugin_t::activate(actor_base_t *actor_) noexcept {
     actor = actor_;
 
     subscribe(&foreigners_support_plugin_t::on_call);
+    subscribe(&foreigners_support_plugin_t::on_multi_call);
     subscribe(&foreigners_support_plugin_t::on_unsubscription);
     subscribe(&foreigners_support_plugin_t::on_subscription_external);
 
@@ -48,27 +49,48 @@ void foreigners_support_plugin_t::deactivate() noexcept {
 }
 
 void foreigners_support_plugin_t::on_call(message::handler_call_t &message) noexcept {
-    auto &handler = message.payload.handler;
-    auto child_actor = handler->actor_ptr;
+    auto &payload = message.payload;
+    call(payload.handler, payload.subscription, payload.orig_message);
+}
+
+void foreigners_support_plugin_t::on_multi_call(message::multi_handler_call_t &message) noexcept {
+    auto &orig_message = message.payload.orig_message;
+    for (auto &target : message.payload.targets) {
+        call(target.handler, target.subscription, orig_message);
+    }
+}
+
+void foreigners_support_plugin_t::call(const handler_ptr_t &handler, const subscription_info_ptr_t &subscription,
+                                       message_ptr_t &orig_message) noexcept {
     // need to check, that
-    // 1. children exists
-    // 2. check it's state
-    // 2. it is still subscribed to the message
+    // 1. the subscription is still alive (if the handle is available)
+    // 2. children exists
+    // 3. check it's state
+    // 4. it is still subscribed to the message (if there is no handle)
+    if (subscription && !subscription->is_live()) {
+        return;
+    }
 
+    auto child_actor = handler->actor_ptr;
     auto &sup = static_cast<supervisor_t &>(*actor);
-    if (sup.access<to::alive_actors>().count(child_actor)) {
-        if (child_actor->access<to::state>() < state_t::SHUT_DOWN) {
-            auto &orig_message = message.payload.orig_message;
-            auto point = subscription_point_t(handler, orig_message->address);
-            auto lifetime = child_actor->access<to::lifetime>();
-            if (lifetime) {
-                auto &points = lifetime->access<to::points>();
-                if (points.find(point) != points.end()) {
-                    handler->call(orig_message);
-                }
-            }
+    if (!sup.access<to::alive_actors>().count(child_actor)) {
+        return;
+    }
+    if (child_actor->access<to::state>() >= state_t::SHUT_DOWN) {
+        return;
+    }
+    if (!subscription) {
+        auto point = subscription_point_t(handler, orig_message->address);
+        auto lifetime = child_actor->access<to::lifetime>();
+        if (!lifetime) {
+            return;
+        }
+        auto &points = lifetime->access<to::points>();
+        if (points.find(point) == points.end()) {
+            return;
         }
     }
+    handler->call(orig_message);
 }
 
 void foreigners_support_plugin_t::on_subscription_external(message::external_subscription_t &message) noexcept {
@@ -76,6 +98,7 @@ void foreigners_support_plugin_t::on_subscription_external(message::external_sub
     auto &point = message.payload.point;
     assert(&point.address->supervisor == &sup);
     auto info = sup.subscribe(point.handler, point.address, point.owner_ptr, owner_tag_t::FOREIGN);
+    info->origin = message.payload.origin;
     foreign_points.emplace_back(info);
 }
 
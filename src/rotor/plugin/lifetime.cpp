@@ -78,6 +78,12 @@ void lifetime_plugin_t::unsubscribe(const handler_ptr_t &h, const address_ptr_t
     unsubscribe(*it);
 }
 
+void lifetime_plugin_t::unsubscribe(const handler_key_t &key, const address_ptr_t &addr) noexcept {
+    auto it = points.find(key, addr);
+    assert(it != points.end());
+    unsubscribe(*it);
+}
+
 void lifetime_plugin_t::unsubscribe() noexcept {
     auto rit = points.rbegin();
     while (rit != points.rend()) {
@@ -86,6 +92,7 @@ void lifetime_plugin_t::unsubscribe() noexcept {
             unsubscribe(info);
             ++rit;
         } else {
+            info->access<to::state>() = subscription_info_t::state_t::UNSUBSCRIBED;
             auto it = points.erase(--rit.base());
             rit = std::reverse_iterator(it);
         }
@@ -116,6 +123,7 @@ bool lifetime_plugin_t::handle_unsubscription(const subscription_point_t &point,
     if (point.owner_tag != owner_tag_t::PLUGIN) {
         auto it = points.find(point);
         plugin_base_t::forget_subscription(*it);
+        (*it)->access<to::state>() = subscription_info_t::state_t::UNSUBSCRIBED;
         points.erase(it);
         result = true;
         if (points.empty()) {
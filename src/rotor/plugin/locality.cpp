@@ -14,15 +14,17 @@ namespace {
 namespace to {
 struct parent {};
 struct locality_leader {};
-struct inbound_queue {};
-struct inbound_queue_size {};
+struct message_pool {};
+struct use_message_pool {};
+struct hybrid_refcount {};
 } // namespace to
 } // namespace
 
 template <> auto &supervisor_t::access<to::parent>() noexcept { return parent; }
 template <> auto &supervisor_t::access<to::locality_leader>() noexcept { return locality_leader; }
-template <> auto &supervisor_t::access<to::inbound_queue>() noexcept { return inbound_queue; }
-template <> auto &supervisor_t::access<to::inbound_queue_size>() noexcept { return inbound_queue_size; }
+template <> auto &supervisor_t::access<to::message_pool>() noexcept { return message_pool; }
+template <> auto &supervisor_t::access<to::use_message_pool>() noexcept { return use_message_pool; }
+template <> auto &supervisor_t::access<to::hybrid_refcount>() noexcept { return hybrid_refcount; }
 
 const void *locality_plugin_t::class_identity = static_cast<const void *>(typeid(locality_plugin_t).name());
 
@@ -35,9 +37,11 @@ void locality_plugin_t::activate(actor_base_t *actor_) noexcept {
     bool use_other = parent && static_cast<actor_base_t *>(parent)->get_address()->same_locality(*address);
     auto locality_leader = use_other ? parent->access<to::locality_leader>() : &sup;
     sup.access<to::locality_leader>() = locality_leader;
-    if (!use_other) {
-        auto sz = sup.access<to::inbound_queue_size>();
-        sup.access<to::inbound_queue>().reserve_unsafe(sz);
+    if (use_other) {
+        sup.access<to::message_pool>() = locality_leader->access<to::message_pool>();
+        sup.access<to::hybrid_refcount>() = locality_leader->access<to::hybrid_refcount>();
+    } else if (sup.access<to::use_message_pool>()) {
+        sup.access<to::message_pool>() = new message_pool_t();
     }
     return plugin_base_t::activate(actor_);
 }
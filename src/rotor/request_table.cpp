@@ -0,0 +1,48 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/request_table.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace rotor;
+
+namespace {
+constexpr request_id_t generation_mask = (request_table_t::timer_flag - 1) >> request_table_t::slot_bits;
+}
+
+request_table_t::request_table_t() noexcept : free_list{nullptr}, capacity{0}, count{0} {}
+
+request_entry_t &request_table_t::acquire() noexcept {
+    if (!free_list) {
+        assert(capacity + chunk_size <= slot_mask && "too many pending requests");
+        chunks.emplace_back(new request_entry_t[chunk_size]());
+        auto &chunk = chunks.back();
+        for (std::size_t i = chunk_size; i > 0; --i) {
+            auto &entry = chunk[i - 1];
+            entry.id = (request_id_t{1} << slot_bits) | (capacity + i - 1);
+            entry.next = free_list;
+            free_list = &entry;
+        }
+        capacity += chunk_size;
+    }
+    auto &entry = *free_list;
+    free_list = entry.next;
+    entry.next = nullptr;
+    ++count;
+    return entry;
+}
+
+void request_table_t::release(request_entry_t &entry) noexcept {
+    assert(!entry.curry.timer.armed());
+    auto generation = ((entry.id >> slot_bits) + 1) & generation_mask;
+    entry.id = (std::max(generation, request_id_t{1}) << slot_bits) | (entry.id & slot_mask);
+    entry.curry = request_curry_t{};
+    entry.prev = nullptr;
+    entry.next = free_list;
+    free_list = &entry;
+    --count;
+}
@@ -14,11 +14,42 @@ namespace {
 namespace to {
 struct internal_address {};
 struct internal_handler {};
+struct info_slot {};
+struct handler_slot {};
 } // namespace to
 } // namespace
 
 template <> auto &subscription_info_t::access<to::internal_address>() noexcept { return internal_address; }
 template <> auto &subscription_info_t::access<to::internal_handler>() noexcept { return internal_handler; }
+template <> auto &subscription_info_t::access<to::info_slot>() noexcept { return info_slot; }
+template <> auto &subscription_info_t::access<to::handler_slot>() noexcept { return handler_slot; }
+
+namespace {
+/* nullified entries are removed, when there are more of them than alive ones */
+inline bool need_compaction(std::size_t holes, std::size_t size) noexcept { return holes * 2 > size; }
+
+template <typename Items> void compact(Items &items, joint_handlers_t::infos_t &infos, std::size_t &holes) noexcept {
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        if (items[i]) {
+            items[j] = items[i];
+            infos[j] = infos[i];
+            infos[j]->access<to::handler_slot>() = j;
+            ++j;
+        }
+    }
+    items.resize(j);
+    infos.resize(j);
+    holes = 0;
+}
+
+joint_handlers_t::externals_t::iterator find_external(joint_handlers_t::externals_t &externals,
+                                                      const handler_base_t &handler) noexcept {
+    auto sup = &handler.actor_ptr->get_supervisor();
+    auto predicate = [sup](auto &item) { return item.supervisor == sup; };
+    return std::find_if(externals.begin(), externals.end(), predicate);
+}
+} // namespace
 
 subscription_t::subscription_t() noexcept : main_address{nullptr} {}
 
@@ -33,43 +64,62 @@ subscription_info_ptr_t subscription_t::materialize(const subscription_point_t &
 
     if (internal_address) {
         auto &info_list = internal_infos[address];
+        info->access<to::info_slot>() = info_list.size();
         info_list.emplace_back(info);
 
-        auto insert_result = mine_handlers.try_emplace({address.get(), handler->message_type()});
+        auto message_type = handler->message_type();
+        auto insert_result = mine_handlers.try_emplace({address.get(), message_type});
         auto &joint_handlers = insert_result.first->second;
-        auto &handlers = internal_handler ? joint_handlers.internal : joint_handlers.external;
-        handlers.emplace_back(handler.get());
+        if (insert_result.second) {
+            set_dispatch(*address, message_type, &joint_handlers);
+        }
+        if (internal_handler) {
+            info->access<to::handler_slot>() = joint_handlers.internal.size();
+            joint_handlers.internal.emplace_back(joint_handlers_t::entry_t{handler->thunk, handler.get()});
+            joint_handlers.internal_infos.emplace_back(info.get());
+        } else {
+            /* handlers of the same supervisor are grouped for coalesced delivery */
+            auto &externals = joint_handlers.external;
+            auto it = find_external(externals, *handler);
+            if (it == externals.end()) {
+                auto sup = &handler->actor_ptr->get_supervisor();
+                it = externals.insert(it, joint_handlers_t::external_t{sup, {}, 0});
+            }
+            info->access<to::handler_slot>() = it->infos.size();
+            it->infos.emplace_back(info.get());
+        }
     }
 
     return info;
 }
 
-void subscription_t::update(subscription_point_t &point, handler_ptr_t &new_handler) noexcept {
-    auto &address = point.address;
-    auto &handler = point.handler;
-    bool internal_address = address->same_locality(*main_address);
-    bool internal_handler = handler->actor_ptr->get_address()->same_locality(*main_address);
-    if (internal_address) {
+void subscription_t::update(subscription_info_t &info, handler_ptr_t &new_handler) noexcept {
+    auto &address = info.address;
+    auto &handler = info.handler;
+    if (info.access<to::internal_address>()) {
         auto it = mine_handlers.find({address.get(), handler->message_type()});
         assert(it != mine_handlers.end());
         auto &joint_handlers = it->second;
-        auto &handlers = internal_handler ? joint_handlers.internal : joint_handlers.external;
-        auto it_handler = std::find(handlers.begin(), handlers.end(), handler.get());
-        assert(it_handler != handlers.end());
-        *it_handler = new_handler.get();
+        if (info.access<to::internal_handler>()) {
+            auto &entry = joint_handlers.internal[info.access<to::handler_slot>()];
+            assert(entry.handler == handler.get());
+            entry = joint_handlers_t::entry_t{new_handler->thunk, new_handler.get()};
+        }
     }
-    point.handler = new_handler;
+    info.handler = new_handler;
 }
 
-const subscription_t::joint_handlers_t *subscription_t::get_recipients(const message_base_t &message) const noexcept {
-    auto address = message.address.get();
-    auto message_type = message.type_index;
-    auto key = subscrption_key_t{address, message_type};
-    auto it = mine_handlers.find(key);
-    if (it != mine_handlers.end()) {
-        return &it->second;
+void subscription_t::set_dispatch(address_t &address, const void *message_type,
+                                  const joint_handlers_t *handlers) noexcept {
+    auto &table = address.dispatch_table;
+    auto type_id = message_support::get_type_id(message_type);
+    if (type_id >= table.size()) {
+        if (!handlers) {
+            return;
+        }
+        table.resize(type_id + 1, nullptr);
     }
-    return nullptr;
+    table[type_id] = handlers;
 }
 
 void subscription_t::forget(const subscription_info_ptr_t &info) noexcept {
@@ -81,9 +131,14 @@ void subscription_t::forget(const subscription_info_ptr_t &info) noexcept {
     assert(infos_it != info_container.end());
     auto &info_list = infos_it->second;
 
-    auto info_it = std::find_if(info_list.begin(), info_list.end(),
-                                [&info](auto &item) { return item->handler.get() == info->handler.get(); });
-    info_list.erase(info_it);
+    /* the order of address subscriptions does not matter, the last one takes the slot */
+    auto info_slot = info->access<to::info_slot>();
+    assert(info_list[info_slot] == info);
+    if (info_slot + 1 != info_list.size()) {
+        auto &moved = info_list[info_slot] = std::move(info_list.back());
+        moved->access<to::info_slot>() = info_slot;
+    }
+    info_list.pop_back();
     if (info_list.empty()) {
         info_container.erase(infos_it);
     }
@@ -91,14 +146,32 @@ void subscription_t::forget(const subscription_info_ptr_t &info) noexcept {
     auto handler_ptr = info->handler.get();
     auto it = mine_handlers.find({info->address.get(), handler_ptr->message_type()});
     auto &joint_handlers = it->second;
-    auto internal_handler = info->access<to::internal_handler>();
-    auto &handlers = internal_handler ? joint_handlers.internal : joint_handlers.external;
-    auto &misc_handlers = !internal_handler ? joint_handlers.internal : joint_handlers.external;
-    auto predicate = [&handler_ptr](auto &item) { return item == handler_ptr; };
-    auto handler_it = std::find_if(handlers.begin(), handlers.end(), predicate);
-    assert(handler_it != handlers.end());
-    handlers.erase(handler_it);
-    if (handlers.empty() && misc_handlers.empty()) {
+    auto &internal = joint_handlers.internal;
+    auto &externals = joint_handlers.external;
+    auto handler_slot = info->access<to::handler_slot>();
+    if (info->access<to::internal_handler>()) {
+        assert(internal[handler_slot].handler == handler_ptr);
+        internal[handler_slot] = joint_handlers_t::entry_t{nullptr, nullptr};
+        auto &holes = ++joint_handlers.internal_holes;
+        if (need_compaction(holes, internal.size())) {
+            compact(internal, joint_handlers.internal_infos, holes);
+        }
+    } else {
+        auto external_it = find_external(externals, *handler_ptr);
+        assert(external_it != externals.end());
+        auto &infos = external_it->infos;
+        assert(infos[handler_slot] == info.get());
+        infos[handler_slot] = nullptr;
+        auto &holes = ++external_it->holes;
+        if (need_compaction(holes, infos.size())) {
+            compact(infos, infos, holes);
+            if (infos.empty()) {
+                externals.erase(external_it);
+            }
+        }
+    }
+    if (internal.empty() && externals.empty()) {
+        set_dispatch(*info->address, handler_ptr->message_type(), nullptr);
         mine_handlers.erase(it);
     }
 }
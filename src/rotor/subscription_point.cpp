@@ -36,6 +36,16 @@ subscription_container_t::iterator subscription_container_t::find(const subscrip
     return --rit.base();
 }
 
+subscription_container_t::iterator subscription_container_t::find(const handler_key_t &key,
+                                                                  const address_ptr_t &address) noexcept {
+    auto predicate = [&](auto &info) { return *info->handler == key && info->address == address; };
+    auto rit = std::find_if(rbegin(), rend(), predicate);
+    if (rit == rend()) {
+        return end();
+    }
+    return --rit.base();
+}
+
 void subscription_info_t::tag(const void *t) noexcept {
     auto new_handler = handler->upgrade(t);
     auto &sup = handler->actor_ptr->get_supervisor();
@@ -6,6 +6,7 @@
 
 #include "rotor/supervisor.h"
 #include "rotor/registry.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace rotor;
@@ -24,11 +25,17 @@ template <> auto &subscription_info_t::access<to::internal_handler>() noexcept {
 
 supervisor_t::supervisor_t(supervisor_config_t &config)
     : actor_base_t(config), last_req_id{0}, parent{config.supervisor},
-      inbound_queue(0), inbound_queue_size{config.inbound_queue_size}, poll_duration{config.poll_duration},
+      inbound_queue_size{config.inbound_queue_size}, poll_duration{config.poll_duration},
+      process_budget{config.process_budget}, process_slice{config.process_slice},
+      use_message_pool{config.message_pool}, hybrid_refcount{config.hybrid_refcount},
+      request_wheel_tick{config.request_wheel_tick},
+      request_wheel{config.request_wheel_tick.is_positive() ? new timer_wheel_t() : nullptr},
+      timer_slack{config.timer_slack},
       shutdown_flag{config.shutdown_flag}, shutdown_poll_frequency{config.shutdown_poll_frequency},
       create_registry(config.create_registry), synchronize_start(config.synchronize_start),
       registry_address(config.registry_address), policy{config.policy} {
     supervisor = this;
+    queue.prioritize(config.control_lane);
 }
 
 supervisor_t::~supervisor_t() {
@@ -69,7 +76,7 @@ void supervisor_t::do_initialize(system_context_t *ctx) noexcept {
 void supervisor_t::on_start() noexcept {
     actor_base_t::on_start();
     if (shutdown_flag) {
-        start_timer(shutdown_poll_frequency, *this, &supervisor_t::on_shutdown_check_timer);
+        start_periodic_timer(shutdown_poll_frequency, *this, &supervisor_t::on_shutdown_check_timer);
     }
 }
 
@@ -94,7 +101,7 @@ subscription_info_ptr_t supervisor_t::subscribe(const handler_ptr_t &handler, co
     if (sub_info->access<to::internal_address>()) {
         send<payload::subscription_confirmation_t>(handler->actor_ptr->address, point);
     } else {
-        send<payload::external_subscription_t>(addr->supervisor.address, point);
+        send<payload::external_subscription_t>(addr->supervisor.address, point, sub_info);
     }
 
     if (sub_info->access<to::internal_handler>()) {
@@ -118,45 +125,178 @@ void supervisor_t::on_child_shutdown(actor_base_t *) noexcept {
 
 void supervisor_t::intercept(message_ptr_t &, const void *, const continuation_t &cont) noexcept { cont(); }
 
+void supervisor_t::schedule_process() noexcept {}
+
+void supervisor_t::enqueue_batch(messages_queue_t &messages) noexcept {
+    while (!messages.empty()) {
+        enqueue(messages.pop_front());
+    }
+}
+
 void supervisor_t::on_request_trigger(request_id_t timer_id, bool cancelled) noexcept {
-    auto it = request_map.find(timer_id);
-    if (it != request_map.end()) {
-        auto &request_curry = it->second;
+    auto &request_table = locality_leader->request_table;
+    auto entry = request_table.find(timer_id);
+    if (entry) {
+        auto &request_curry = entry->curry;
         auto &actor = *request_curry.source;
+        auto &gather = request_curry.gather;
+        auto receiver = request_curry.receiver;
+        message_ptr_t timeout_message;
         if (!cancelled) {
-            message_ptr_t &request = request_curry.request_message;
             auto ec = make_error_code(error_code_t::request_timeout);
             auto &source = actor.access<to::identity>();
             auto reason = ::make_error(source, ec);
-            auto timeout_message = request_curry.fn(request_curry.origin, *request, reason);
-            put(std::move(timeout_message));
+            if (gather) {
+                put(gather->make_reply(request_curry.origin, reason));
+            } else {
+                message_ptr_t &request = request_curry.request_message;
+                timeout_message = request_curry.fn(request_curry.origin, *request, reason);
+                if (!receiver) {
+                    put(std::move(timeout_message));
+                }
+            }
+        }
+        if (gather) {
+            gather->cancel_pending(*this);
+        } else if (request_curry.cancel_fn && !request_curry.joined) {
+            // the joined request has not been sent, i.e. there is nothing to cancel at the destination
+            put(request_curry.cancel_fn(*request_curry.request_message));
         }
-        auto ait = actor.active_requests.find(timer_id);
-        actor.active_requests.erase(ait);
-        request_map.erase(it);
+        if (request_curry.joined) {
+            leave_flight(timer_id, request_curry.joined);
+        } else if (request_curry.flight) {
+            hand_over_flight(timer_id, request_curry.flight);
+        }
+        actor.active_requests.remove(*entry);
+        request_table.release(*entry);
+        // the receiver might make new requests, so it is notified after release
+        if (receiver) {
+            if (timeout_message) {
+                receiver->on_response(std::move(timeout_message));
+            } else {
+                receiver->on_abandon();
+            }
+        }
+    }
+}
+
+void supervisor_t::leave_flight(request_id_t request_id, request_id_t primary_id) noexcept {
+    auto primary = locality_leader->request_table.find(primary_id);
+    assert(primary && primary->curry.flight);
+    auto &waiters = primary->curry.flight->waiters;
+    auto it = std::find(waiters.begin(), waiters.end(), request_id);
+    if (it != waiters.end()) {
+        waiters.erase(it);
     }
 }
 
+void supervisor_t::hand_over_flight(request_id_t request_id, request_flight_ptr_t &flight) noexcept {
+    auto &flights = locality_leader->request_flights;
+    auto range = flights.equal_range(flight->hash);
+    auto it = range.first;
+    while (it != range.second && it->second != request_id) {
+        ++it;
+    }
+    assert(it != range.second);
+    if (flight->waiters.empty()) {
+        flights.erase(it);
+        return;
+    }
+
+    // the request has not been replied, so the first joined request takes
+    // over the flight and it is sent to the destination on its own
+    auto &request_table = locality_leader->request_table;
+    auto heir_id = flight->waiters.front();
+    flight->waiters.erase(flight->waiters.begin());
+    for (auto waiter_id : flight->waiters) {
+        request_table.find(waiter_id)->curry.joined = heir_id;
+    }
+    auto heir = request_table.find(heir_id);
+    assert(heir && heir->curry.joined == request_id);
+    heir->curry.joined = 0;
+    heir->curry.flight = std::move(flight);
+    it->second = heir_id;
+    put(heir->curry.request_message);
+}
+
 void supervisor_t::discard_request(request_id_t request_id) noexcept {
-    assert(request_map.find(request_id) != request_map.end());
-    cancel_timer(request_id);
-    request_map.erase(request_id);
+    auto entry = locality_leader->request_table.find(request_id);
+    assert(entry);
+    // the request is completed, i.e. there is nothing to cancel at the destination
+    entry->curry.cancel_fn = nullptr;
+    entry->curry.receiver = nullptr;
+    cancel_request_timer(request_id);
+    assert(!locality_leader->request_table.find(request_id));
+}
+
+void supervisor_t::start_request_timer(request_id_t request_id, const pt::time_duration &timeout) noexcept {
+    auto leader = locality_leader;
+    auto &wheel = leader->request_wheel;
+    if (!wheel) {
+        start_timer(request_id, timeout, *this, &supervisor_t::on_request_trigger);
+        return;
+    }
+
+    auto tick = leader->request_wheel_tick.total_microseconds();
+    auto ticks = std::uint64_t((std::max(timeout.total_microseconds(), decltype(tick){0}) + tick - 1) / tick);
+    // the running tick timer is already partially elapsed, so the request
+    // would expire earlier than requested without one more tick
+    if (leader->wheel_timer_id) {
+        ++ticks;
+    }
+    auto &timer = leader->request_table.find(request_id)->curry.timer;
+    timer.supervisor = this;
+    timer.request_id = request_id;
+    wheel->arm(timer, ticks);
+    if (!leader->wheel_timer_id) {
+        leader->wheel_timer_id =
+            leader->start_periodic_timer(leader->request_wheel_tick, *leader, &supervisor_t::on_wheel_tick);
+    }
+}
+
+void supervisor_t::cancel_request_timer(request_id_t request_id) noexcept {
+    auto &wheel = locality_leader->request_wheel;
+    if (!wheel) {
+        cancel_timer(request_id);
+        return;
+    }
+    auto &timer = locality_leader->request_table.find(request_id)->curry.timer;
+    if (timer.armed()) {
+        wheel->cancel(timer);
+    }
+    on_request_trigger(request_id, true);
+}
+
+void supervisor_t::on_wheel_tick(request_id_t timer_id, bool cancelled) noexcept {
+    if (cancelled) {
+        if (timer_id == wheel_timer_id) {
+            wheel_timer_id = 0;
+        }
+        return;
+    }
+    request_wheel->tick([](timer_wheel_t::node_t &node) {
+        auto &timer = static_cast<request_timer_t &>(node);
+        timer.supervisor->on_request_trigger(timer.request_id, false);
+    });
+    if (request_wheel->empty()) {
+        wheel_timer_id = 0;
+        cancel_timer(timer_id);
+    }
 }
 
 void supervisor_t::shutdown_finish() noexcept {
     actor_base_t::shutdown_finish();
-    assert(request_map.size() == 0);
+    assert(locality_leader != this || (request_table.empty() && request_flights.empty()));
 }
 
 spawner_t supervisor_t::spawn(factory_t factory) noexcept { return spawner_t(std::move(factory), *this); }
 
-void supervisor_t::on_shutdown_check_timer(request_id_t, bool cancelled) noexcept {
+void supervisor_t::on_shutdown_check_timer(request_id_t timer_id, bool cancelled) noexcept {
     if (cancelled) {
         return;
     }
     if (*shutdown_flag) {
+        cancel_timer(timer_id);
         do_shutdown();
-    } else {
-        start_timer(shutdown_poll_frequency, *this, &supervisor_t::on_shutdown_check_timer);
     }
 }
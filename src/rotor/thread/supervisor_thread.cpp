@@ -25,8 +25,13 @@ void supervisor_thread_t::shutdown() noexcept {
 void supervisor_thread_t::enqueue(message_ptr_t message) noexcept {
     auto ctx = static_cast<system_context_thread_t *>(context);
     inbound_queue.push(message.detach());
-    std::lock_guard<std::mutex> lock(ctx->mutex);
-    ctx->cv.notify_one();
+    ctx->wake();
+}
+
+void supervisor_thread_t::enqueue_batch(messages_queue_t &messages) noexcept {
+    auto ctx = static_cast<system_context_thread_t *>(context);
+    inbound_queue.push(messages);
+    ctx->wake();
 }
 
 void supervisor_thread_t::intercept(message_ptr_t &message, const void *tag,
@@ -45,12 +50,12 @@ void supervisor_thread_t::intercept(message_ptr_t &message, const void *tag,
 
 void supervisor_thread_t::do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
     auto ctx = static_cast<system_context_thread_t *>(context);
-    ctx->start_timer(interval, handler);
+    ctx->start_timer(interval, handler, timer_slack);
 }
 
-void supervisor_thread_t::do_cancel_timer(request_id_t timer_id) noexcept {
+void supervisor_thread_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
     auto ctx = static_cast<system_context_thread_t *>(context);
-    ctx->cancel_timer(timer_id);
+    ctx->cancel_timer(handler);
 }
 
 void supervisor_thread_t::update_time() noexcept {
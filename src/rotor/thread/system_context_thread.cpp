@@ -6,6 +6,8 @@
 
 #include "rotor/thread/system_context_thread.h"
 #include "rotor/supervisor.h"
+#include <algorithm>
+#include <cassert>
 #include <chrono>
 
 namespace rotor {
@@ -43,33 +45,36 @@ void system_context_thread_t::run() noexcept {
     auto &inbound = root_sup.access<to::inbound_queue>();
     auto &poll_duration = root_sup.access<to::poll_duration>();
 
-    auto process = [&]() -> bool {
-        message_base_t *ptr;
-        if (inbound.pop(ptr)) {
-            queue.emplace_back(ptr, false);
-            return true;
-        }
-        return false;
-    };
+    auto process = [&]() -> bool { return inbound.drain(queue) > 0; };
 
     auto delta = time_units_t{poll_duration.total_microseconds()};
     while (condition()) {
         root_sup.do_process();
         if (condition()) {
+            if (!queue.empty()) {
+                /* the budget is exhausted: fire timers and take inbound messages before the next round */
+                check();
+                continue;
+            }
             using namespace std::chrono_literals;
             auto dealine = clock_t::now() + delta;
-            if (!timer_nodes.empty()) {
-                dealine = std::min(dealine, timer_nodes.front().deadline);
+            if (!timers.empty()) {
+                dealine = std::min(dealine, timers.next_deadline());
             }
             // fast stage, indirect spin-lock, cpu consuming
             while ((clock_t::now() < dealine) && !process()) {
             }
             if (queue.empty()) {
+                // the parked state is published before checking the inbound queue (see `wake`), so
+                // either the message is seen here, or the producer sees the state and notifies
+                parked.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
                 std::unique_lock<std::mutex> lock(mutex);
                 auto predicate = [&]() { return !inbound.empty(); };
                 // wait notification, do not consume CPU
-                auto next_timer_deadline = !timer_nodes.empty() ? timer_nodes.front().deadline : dealine + 1h;
+                auto next_timer_deadline = !timers.empty() ? timers.next_deadline() : dealine + 1h;
                 cv.wait_until(lock, next_timer_deadline, predicate);
+                parked.store(false, std::memory_order_relaxed);
             }
             update_time();
             root_sup.do_process();
@@ -77,49 +82,50 @@ void system_context_thread_t::run() noexcept {
     }
 }
 
+void system_context_thread_t::wake() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_one();
+    }
+}
+
 void system_context_thread_t::check() noexcept {
     auto &root_sup = *get_supervisor();
     auto &queue = root_sup.access<to::queue>();
     auto &inbound = root_sup.access<to::inbound_queue>();
-    message_base_t *ptr;
-    while (inbound.pop(ptr)) {
-        queue.emplace_back(ptr, false);
-    }
+    inbound.drain(queue);
     update_time();
 }
 
 void system_context_thread_t::update_time() noexcept {
     now = clock_t::now();
-    auto it = timer_nodes.begin();
-    while (it != timer_nodes.end() && it->deadline < now) {
-        auto actor_ptr = it->handler->owner;
-        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(it->handler->request_id, false);
-        it = timer_nodes.erase(it);
+    if (timers.empty() || !(timers.next_deadline() < now)) {
+        return;
+    }
+    timer_wakeups.fetch_add(1, std::memory_order_relaxed);
+    // the handler might arm or cancel timers, so the timer is unlinked before the invocation
+    while (auto handler = timers.pop_expired(now)) {
+        auto actor_ptr = handler->owner;
+        auto timer_id = handler->request_id;
+        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
     }
 }
 
-void system_context_thread_t::start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
+void system_context_thread_t::start_timer(const pt::time_duration &interval, timer_handler_base_t &handler,
+                                          const pt::time_duration &slack) noexcept {
     if (intercepting)
         update_time();
-    auto deadline = now + time_units_t{interval.total_microseconds()};
-    auto it = timer_nodes.begin();
-    for (; it != timer_nodes.end(); ++it) {
-        if (deadline < it->deadline) {
-            break;
-        }
-    }
-    timer_nodes.insert(it, deadline_info_t{&handler, deadline});
+    timers.push(handler, now + time_units_t{interval.total_microseconds()}, time_units_t{slack.total_microseconds()});
 }
 
-void system_context_thread_t::cancel_timer(request_id_t timer_id) noexcept {
+void system_context_thread_t::cancel_timer(timer_handler_base_t &handler) noexcept {
     if (intercepting)
         update_time();
-    auto predicate = [&](auto &info) { return info.handler->request_id == timer_id; };
-    auto it = std::find_if(timer_nodes.begin(), timer_nodes.end(), predicate);
-    assert(it != timer_nodes.end() && "timer has been found");
-    auto &actor_ptr = it->handler->owner;
-    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, true);
-    timer_nodes.erase(it);
+    auto removed = timers.remove(handler);
+    assert(removed && "timer has been found");
+    (void)removed;
+    handler.owner->access<to::on_timer_trigger, request_id_t, bool>(handler.request_id, true);
 }
 
 } // namespace rotor
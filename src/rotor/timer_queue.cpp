@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/timer_queue.h"
+#include <algorithm>
+
+using namespace rotor;
+
+namespace {
+constexpr std::size_t arity = 4;
+
+template <typename T> inline bool earlier(const T &lhs, const T &rhs) noexcept {
+    return lhs.deadline < rhs.deadline || (lhs.deadline == rhs.deadline && lhs.sequence < rhs.sequence);
+}
+} // namespace
+
+void timer_queue_t::push(timer_handler_base_t &handler, clock_t::time_point deadline,
+                         const clock_t::duration &slack) noexcept {
+    if (slack.count() > 0) {
+        auto rest = deadline.time_since_epoch() % slack;
+        if (rest.count()) {
+            deadline += slack - rest;
+        }
+    }
+    nodes.emplace_back(node_t{&handler, deadline, ++sequence});
+    sift_up(nodes.size() - 1);
+}
+
+bool timer_queue_t::remove(timer_handler_base_t &handler) noexcept {
+    auto index = handler.heap_index;
+    if (index >= nodes.size() || nodes[index].handler != &handler) {
+        return false;
+    }
+    erase(index);
+    return true;
+}
+
+auto timer_queue_t::pop_expired(const clock_t::time_point &now) noexcept -> handler_ptr_t {
+    if (nodes.empty() || !(nodes.front().deadline < now)) {
+        return nullptr;
+    }
+    auto handler = nodes.front().handler;
+    erase(0);
+    return handler;
+}
+
+void timer_queue_t::place(std::size_t index, const node_t &node) noexcept {
+    nodes[index] = node;
+    node.handler->heap_index = index;
+}
+
+void timer_queue_t::sift_up(std::size_t index) noexcept {
+    auto node = nodes[index];
+    while (index > 0) {
+        auto parent = (index - 1) / arity;
+        if (!earlier(node, nodes[parent])) {
+            break;
+        }
+        place(index, nodes[parent]);
+        index = parent;
+    }
+    place(index, node);
+}
+
+void timer_queue_t::sift_down(std::size_t index) noexcept {
+    auto node = nodes[index];
+    auto size = nodes.size();
+    while (true) {
+        auto first = index * arity + 1;
+        if (first >= size) {
+            break;
+        }
+        auto best = first;
+        for (auto child = first + 1; child < std::min(first + arity, size); ++child) {
+            if (earlier(nodes[child], nodes[best])) {
+                best = child;
+            }
+        }
+        if (!earlier(nodes[best], node)) {
+            break;
+        }
+        place(index, nodes[best]);
+        index = best;
+    }
+    place(index, node);
+}
+
+void timer_queue_t::erase(std::size_t index) noexcept {
+    nodes[index].handler->heap_index = timer_handler_base_t::unlinked;
+    auto last = nodes.back();
+    nodes.pop_back();
+    if (index < nodes.size()) {
+        place(index, last);
+        if (index > 0 && earlier(last, nodes[(index - 1) / arity])) {
+            sift_up(index);
+        } else {
+            sift_down(index);
+        }
+    }
+}
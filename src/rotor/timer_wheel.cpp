@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/timer_wheel.h"
+#include <cassert>
+
+using namespace rotor;
+
+namespace {
+constexpr std::uint64_t mask = timer_wheel_t::slots - 1;
+
+constexpr std::uint64_t span(unsigned level) noexcept {
+    return std::uint64_t{1} << (timer_wheel_t::level_bits * (level + 1));
+}
+} // namespace
+
+timer_wheel_t::timer_wheel_t() noexcept : current{0}, count{0} {
+    for (auto &level : buckets) {
+        for (auto &bucket : level) {
+            bucket.prev = bucket.next = &bucket;
+        }
+    }
+}
+
+void timer_wheel_t::arm(node_t &node, std::uint64_t ticks) noexcept {
+    assert(!node.armed());
+    node.deadline = current + (ticks ? ticks : 1);
+    insert(node);
+    ++count;
+}
+
+void timer_wheel_t::cancel(node_t &node) noexcept {
+    assert(node.armed());
+    unlink(node);
+}
+
+void timer_wheel_t::insert(node_t &node) noexcept {
+    auto delta = node.deadline > current ? node.deadline - current : 0;
+    unsigned level = 0;
+    while (level + 1 < levels && delta >= span(level)) {
+        ++level;
+    }
+    /* too far: park it in the farthest bucket, it will be re-cascaded */
+    auto deadline = delta < span(levels - 1) ? node.deadline : current + span(levels - 1) - 1;
+    auto &bucket = buckets[level][(deadline >> (level_bits * level)) & mask];
+    node.prev = bucket.prev;
+    node.next = &bucket;
+    bucket.prev->next = &node;
+    bucket.prev = &node;
+}
+
+void timer_wheel_t::unlink(node_t &node) noexcept {
+    node.prev->next = node.next;
+    node.next->prev = node.prev;
+    node.prev = node.next = nullptr;
+    --count;
+}
+
+void timer_wheel_t::splice(node_t &from, node_t &to) noexcept {
+    if (from.next == &from) {
+        to.prev = to.next = &to;
+        return;
+    }
+    to.next = from.next;
+    to.prev = from.prev;
+    to.next->prev = &to;
+    to.prev->next = &to;
+    from.prev = from.next = &from;
+}
+
+void timer_wheel_t::cascade(unsigned level) noexcept {
+    auto &bucket = buckets[level][(current >> (level_bits * level)) & mask];
+    node_t pending;
+    splice(bucket, pending);
+    while (pending.next != &pending) {
+        auto node = pending.next;
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        insert(*node);
+    }
+}
+
+void timer_wheel_t::advance() noexcept {
+    ++current;
+    /* higher levels first, so their nodes get a chance to cascade down to level 0 */
+    unsigned top = 0;
+    while (top + 1 < levels && (current & (span(top) - 1)) == 0) {
+        ++top;
+    }
+    for (unsigned level = top; level > 0; --level) {
+        cascade(level);
+    }
+}
@@ -6,6 +6,10 @@
 
 #include "rotor/wx/supervisor_wx.h"
 #include <wx/timer.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <memory>
 
 using namespace rotor::wx;
 using namespace rotor;
@@ -26,23 +30,9 @@ inline auto rotor::actor_base_t::access<to::on_timer_trigger, request_id_t, bool
 }
 } // namespace rotor
 
-supervisor_wx_t::timer_t::timer_t(timer_handler_base_t *handler_, supervisor_ptr_t &&sup_)
-    : handler{handler_}, sup{std::move(sup_)} {}
+supervisor_wx_t::timer_t::timer_t(supervisor_wx_t &sup_) noexcept : sup{sup_} {}
 
-void supervisor_wx_t::timer_t::Notify() noexcept {
-    auto timer_id = handler->request_id;
-    auto *supervisor = sup.get();
-    auto &timers_map = sup->timers_map;
-
-    try {
-        auto actor_ptr = timers_map.at(timer_id)->handler->owner;
-        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
-        timers_map.erase(timer_id);
-        supervisor->do_process();
-    } catch (std::out_of_range &ex) {
-        // no-op
-    }
-}
+void supervisor_wx_t::timer_t::Notify() noexcept { sup.on_native_timer(); }
 
 supervisor_wx_t::supervisor_wx_t(supervisor_config_wx_t &config_) : supervisor_t{config_}, handler{config_.handler} {}
 
@@ -65,31 +55,89 @@ void supervisor_wx_t::shutdown() noexcept {
     });
 }
 
+void supervisor_wx_t::schedule_process() noexcept {
+    supervisor_ptr_t self{this};
+    handler->CallAfter([self = std::move(self)]() { self->do_process(); });
+}
+
 void supervisor_wx_t::enqueue(message_ptr_t message) noexcept {
     supervisor_ptr_t self{this};
-    handler->CallAfter([self = std::move(self), message = std::move(message)]() {
+    handler->CallAfter([self = std::move(self), message = std::move(message)]() mutable {
+        auto &sup = *self;
+        sup.put(std::move(message));
+        sup.do_process();
+    });
+}
+
+void supervisor_wx_t::enqueue_batch(messages_queue_t &messages) noexcept {
+    /* wx copies the callback, so the (non-copyable) batch is shared */
+    supervisor_ptr_t self{this};
+    auto batch = std::make_shared<messages_queue_t>(std::move(messages));
+    handler->CallAfter([self = std::move(self), batch = std::move(batch)]() {
         auto &sup = *self;
-        sup.put(message);
+        while (!batch->empty()) {
+            sup.put(batch->pop_front());
+        }
         sup.do_process();
     });
 }
 
 void supervisor_wx_t::do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
-    auto self = timer_t::supervisor_ptr_t(this);
-    auto timer = std::make_unique<timer_t>(&handler, std::move(self));
-    auto timeout_ms = static_cast<int>(interval.total_milliseconds());
-    timer->StartOnce(timeout_ms);
-    timers_map.emplace(handler.request_id, std::move(timer));
+    using time_units_t = std::chrono::microseconds;
+    auto deadline = timer_queue_t::clock_t::now() + time_units_t{interval.total_microseconds()};
+    timers.push(handler, deadline, time_units_t{timer_slack.total_microseconds()});
+    if (!native_armed || timers.next_deadline() < native_deadline) {
+        arm_timer();
+    }
+}
+
+void supervisor_wx_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
+    auto removed = timers.remove(handler);
+    assert(removed && "timer has been found");
+    (void)removed;
+    auto actor_ptr = handler.owner;
+    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(handler.request_id, true);
+    // the native timer is left armed, unless there are no more timers, i.e. the early
+    // wakeup just re-arms it
+    if (timers.empty() && native_armed) {
+        native_armed = false;
+        native_timer->Stop();
+        intrusive_ptr_release(this);
+    }
+}
+
+void supervisor_wx_t::arm_timer() noexcept {
+    using namespace std::chrono;
+    if (!native_timer) {
+        native_timer = std::make_unique<timer_t>(*this);
+    }
+    native_deadline = timers.next_deadline();
+    auto left = ceil<milliseconds>(native_deadline - timer_queue_t::clock_t::now());
+    if (!native_armed) {
+        native_armed = true;
+        intrusive_ptr_add_ref(this);
+    }
+    // wx does not accept zero timeout; the running timer is restarted
+    native_timer->StartOnce(static_cast<int>(std::max(left.count(), milliseconds::rep{1})));
 }
 
-void supervisor_wx_t::do_cancel_timer(request_id_t timer_id) noexcept {
-    try {
-        auto &timer = timers_map.at(timer_id);
-        timer->Stop();
-        auto actor_ptr = timer->handler->owner;
-        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, true);
-        timers_map.erase(timer_id);
-    } catch (std::out_of_range &ex) {
-        // no-op
+void supervisor_wx_t::on_native_timer() noexcept {
+    // the native timer is not running anymore, but the reference is still held
+    native_armed = false;
+    auto now = timer_queue_t::clock_t::now();
+    bool triggered = false;
+    // the handler might arm or cancel timers, so the timer is unlinked before the invocation
+    while (auto handler = timers.pop_expired(now)) {
+        auto actor_ptr = handler->owner;
+        auto timer_id = handler->request_id;
+        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
+        triggered = true;
+    }
+    if (!native_armed && !timers.empty()) {
+        arm_timer();
+    }
+    if (triggered) {
+        do_process();
     }
+    intrusive_ptr_release(this);
 }
@@ -178,6 +178,7 @@ struct unsubscriber_sup_t : public rt::supervisor_test_t {
     }
 
     void on_sample(message::sample_payload_t &) noexcept {}
+    void on_other_sample(message::sample_payload_t &) noexcept {}
 };
 
 struct sample_actor_t : public r::actor_base_t {
@@ -287,6 +288,29 @@ struct sample_actor7_t : public rt::actor_test_t {
     void on_message(message::sample_payload_t &) noexcept {}
 };
 
+struct sample_actor8_t : public rt::actor_test_t {
+    using rt::actor_test_t::actor_test_t;
+
+    void on_start() noexcept override {
+        rt::actor_test_t::on_start();
+        timer_id = start_periodic_timer(r::pt::minutes(1), *this, &sample_actor8_t::on_timer);
+    }
+
+    void on_timer(r::request_id_t id, bool cancelled) noexcept {
+        CHECK(id == timer_id);
+        if (cancelled) {
+            ++cancellations;
+        } else if (++triggerings == stop_at) {
+            cancel_timer(id);
+        }
+    }
+
+    r::request_id_t timer_id = 0;
+    int triggerings = 0;
+    int cancellations = 0;
+    int stop_at = 0;
+};
+
 TEST_CASE("on_initialize, on_start, simple on_shutdown (handled by plugin)", "[supervisor]") {
     destroyed = 0;
     r::system_context_t *system_context = new r::system_context_t{};
@@ -365,15 +389,9 @@ TEST_CASE("start/shutdown 1 child & 1 supervisor", "[supervisor]") {
 
     CHECK_THAT(act->get_identity(), StartsWith("actor"));
 
-    /* for better coverage */
-    auto last = sup->access<rt::to::last_req_id>();
-    auto &request_map = sup->access<rt::to::request_map>();
-    request_map[last + 1] = r::request_curry_t();
-
     sup->do_process();
-    request_map.clear();
 
-    CHECK(sup->access<rt::to::last_req_id>() > 1);
+    CHECK(sup->access<rt::to::request_table>().empty());
     CHECK(sup->get_state() == r::state_t::OPERATIONAL);
     CHECK(act->access<rt::to::state>() == r::state_t::OPERATIONAL);
     CHECK(act->access<rt::to::resources>()->has() == 0);
@@ -432,6 +450,32 @@ TEST_CASE("self unsubscriber", "[actor]") {
     CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
 }
 
+TEST_CASE("handlers interning", "[actor]") {
+    r::system_context_ptr_t system_context = new r::system_context_t();
+    auto sup = system_context->create_supervisor<unsubscriber_sup_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::OPERATIONAL);
+
+    auto handler = r::wrap_handler(*sup, &unsubscriber_sup_t::on_sample);
+    CHECK(r::wrap_handler(*sup, &unsubscriber_sup_t::on_sample).get() == handler.get());
+    CHECK(r::wrap_handler(*sup, &unsubscriber_sup_t::on_other_sample).get() != handler.get());
+
+    auto info = sup->subscribe(&unsubscriber_sup_t::on_sample);
+    CHECK(info->handler.get() == handler.get());
+    sup->do_process();
+
+    sup->unsubscribe(&unsubscriber_sup_t::on_sample);
+    sup->do_process();
+    CHECK(!info->is_live());
+    CHECK(sup->subscribe(&unsubscriber_sup_t::on_sample)->handler.get() == handler.get());
+    sup->do_process();
+    handler.reset();
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+}
+
 TEST_CASE("alternative address subscriber", "[actor]") {
     r::system_context_ptr_t system_context = new r::system_context_t();
     auto sup = system_context->create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
@@ -520,6 +564,48 @@ TEST_CASE("timers cancellation", "[actor]") {
     CHECK(act->access<rt::to::timers_map>().empty());
 }
 
+TEST_CASE("periodic timer", "[actor]") {
+    r::system_context_ptr_t system_context = new r::system_context_t();
+    auto sup = system_context->create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto act = sup->create_actor<sample_actor8_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+    CHECK(act->get_state() == r::state_t::OPERATIONAL);
+    REQUIRE(sup->active_timers.size() == 1);
+    auto &timers = act->access<rt::to::timers_map>();
+    auto handler = timers.at(act->timer_id).get();
+
+    for (int i = 1; i <= 3; ++i) {
+        sup->do_invoke_timer(act->timer_id);
+        CHECK(act->triggerings == i);
+        REQUIRE(sup->active_timers.size() == 1);
+        CHECK(sup->get_timer(0) == act->timer_id);
+        CHECK(timers.size() == 1);
+        CHECK(timers.at(act->timer_id).get() == handler);
+    }
+
+    SECTION("cancellation from callback") {
+        act->stop_at = 4;
+        sup->do_invoke_timer(act->timer_id);
+        CHECK(act->triggerings == 4);
+        CHECK(act->cancellations == 1);
+        CHECK(sup->active_timers.empty());
+        CHECK(timers.empty());
+    }
+
+    SECTION("cancellation upon shutdown") {
+        sup->do_shutdown();
+        sup->do_process();
+        CHECK(act->triggerings == 3);
+        CHECK(act->cancellations == 1);
+    }
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(act->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup->active_timers.empty());
+}
+
 TEST_CASE("subscription confirmation arrives on non-init phase", "[actor]") {
     r::system_context_ptr_t system_context = new r::system_context_t();
     auto sup = system_context->create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
@@ -528,8 +614,7 @@ TEST_CASE("subscription confirmation arrives on non-init phase", "[actor]") {
     auto act_configurer = [&](auto &, r::plugin::plugin_base_t &plugin) {
         plugin.with_casted<r::plugin::starter_plugin_t>([&](auto &p) {
             p.subscribe_actor(r::lambda<message::sample_payload_t>([](message::sample_payload_t &) noexcept { ; }));
-            auto req = sup->get_leader_queue().back();
-            sup->get_leader_queue().pop_back();
+            auto req = sup->get_leader_queue().pop_back();
             act->msg = std::move(req);
             act->do_shutdown();
         });
@@ -540,3 +625,38 @@ TEST_CASE("subscription confirmation arrives on non-init phase", "[actor]") {
     CHECK(act->get_state() == r::state_t::SHUT_DOWN);
     CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
 }
+
+TEST_CASE("control messages lane", "[supervisor]") {
+    r::system_context_ptr_t system_context = new r::system_context_t();
+    bool control_lane = false;
+    std::size_t expected = 0;
+
+    SECTION("control lane is disabled") {
+        control_lane = false;
+        expected = 2;
+    }
+    SECTION("control lane is enabled") {
+        control_lane = true;
+        expected = 0;
+    }
+
+    auto sup = system_context->create_supervisor<rt::supervisor_test_t>()
+                   .timeout(rt::default_timeout)
+                   .control_lane(control_lane)
+                   .finish();
+    auto act = sup->create_actor<sample_actor4_t>().timeout(rt::default_timeout).finish();
+    CHECK(sup->get_leader_queue().is_prioritized() == control_lane);
+
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::OPERATIONAL);
+    CHECK(act->received == 2);
+
+    act->send<payload::sample_payload_t>(act->get_address());
+    act->send<payload::sample_payload_t>(act->get_address());
+    sup->do_shutdown();
+    sup->do_process();
+
+    CHECK(act->received == 2 + expected);
+    CHECK(act->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+}
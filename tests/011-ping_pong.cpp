@@ -91,3 +91,38 @@ TEST_CASE("ping-pong", "[supervisor]") {
     ponger.reset();
     REQUIRE(destroyed == 4);
 }
+
+TEST_CASE("ping-pong, budgeted processing", "[supervisor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>()
+                   .timeout(rt::default_timeout)
+                   .process_budget(2)
+                   .finish();
+    auto pinger = sup->create_actor<pinger_t>().timeout(rt::default_timeout).finish();
+    auto ponger = sup->create_actor<ponger_t>().timeout(rt::default_timeout).finish();
+
+    pinger->set_ponger_addr(ponger->get_address());
+    ponger->set_pinger_addr(pinger->get_address());
+
+    sup->do_process();
+    CHECK(sup->get_process_stats().budget_hits == 1);
+    CHECK(!sup->get_leader_queue().empty());
+
+    std::size_t rounds = 1;
+    while (!sup->get_leader_queue().empty()) {
+        sup->do_process();
+        ++rounds;
+    }
+    CHECK(rounds > 2);
+    CHECK(sup->get_process_stats().budget_hits == rounds - 1);
+    CHECK(sup->get_process_stats().slice_hits == 0);
+    CHECK(pinger->pong_received == 1);
+    CHECK(ponger->ping_received == 1);
+
+    sup->do_shutdown();
+    while (!sup->get_leader_queue().empty()) {
+        sup->do_process();
+    }
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+}
@@ -84,3 +84,37 @@ TEST_CASE("ping-pong", "[supervisor]") {
     REQUIRE(sup->get_points().size() == 0);
     CHECK(rt::empty(sup->get_subscription()));
 }
+
+TEST_CASE("unsubscription in the middle", "[supervisor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto pub_addr = sup->create_address();
+    auto sub1 = sup->create_actor<sub_t>().pub_addr(pub_addr).timeout(rt::default_timeout).finish();
+    auto sub2 = sup->create_actor<sub_t>().pub_addr(pub_addr).timeout(rt::default_timeout).finish();
+    auto sub3 = sup->create_actor<sub_t>().pub_addr(pub_addr).timeout(rt::default_timeout).finish();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::OPERATIONAL);
+
+    sub2->do_shutdown();
+    sup->do_process();
+    REQUIRE(sub2->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+
+    sup->send<payload_t>(pub_addr);
+    sup->do_process();
+    CHECK(sub1->received == 1);
+    CHECK(sub2->received == 0);
+    CHECK(sub3->received == 1);
+
+    sub1->do_shutdown();
+    sup->do_process();
+    sup->send<payload_t>(pub_addr);
+    sup->do_process();
+    CHECK(sub1->received == 1);
+    CHECK(sub3->received == 2);
+
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(rt::empty(sup->get_subscription()));
+}
@@ -414,6 +414,121 @@ struct res_actor_t : r::actor_base_t {
     req_ptr_t req;
 };
 
+struct cancelling_requester_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    r::address_ptr_t responder;
+    bool auto_cancel = true;
+    r::extended_error_ptr_t ee;
+    int responses = 0;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        plugin.with_casted<r::plugin::starter_plugin_t>(
+            [](auto &p) { p.subscribe_actor(&cancelling_requester_t::on_response); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        request<request_sample_t>(responder, 4).auto_cancel(auto_cancel).send(rt::default_timeout);
+    }
+
+    void on_response(traits_t::response::message_t &msg) noexcept {
+        ++responses;
+        ee = msg.payload.ee;
+    }
+};
+
+struct tracking_responder_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    r::inflight_requests_t inflight;
+    req_ptr_t req;
+    int cancellations = 0;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) {
+            p.subscribe_actor(&tracking_responder_t::on_request);
+            p.subscribe_actor(&tracking_responder_t::on_cancel);
+        });
+    }
+
+    void shutdown_start() noexcept override {
+        req.reset();
+        r::actor_base_t::shutdown_start();
+    }
+
+    void on_request(traits_t::request::message_t &msg) noexcept {
+        inflight.track(msg.payload);
+        req = &msg;
+    }
+
+    void on_cancel(traits_t::cancel::message_t &msg) noexcept {
+        ++cancellations;
+        inflight.cancel(msg.payload);
+    }
+
+    void do_reply() noexcept {
+        if (inflight.forget(req->payload)) {
+            reply_to(*req, 5);
+        }
+    }
+};
+
+struct counted_res_t {
+    static inline int copies = 0;
+
+    int value = 0;
+    counted_res_t() = default;
+    counted_res_t(int value_) : value{value_} {}
+    counted_res_t(const counted_res_t &other) : value{other.value} { ++copies; }
+    counted_res_t(counted_res_t &&other) = default;
+};
+
+struct counted_req_t {
+    using response_t = counted_res_t;
+    int value;
+};
+
+struct counting_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+    using counted_traits_t = r::request_traits_t<counted_req_t>;
+
+    int res_val = 0;
+    r::address_ptr_t res_address;
+    r::intrusive_ptr_t<counted_traits_t::response::message_t> kept_res;
+    bool keep_response = false;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) {
+            p.subscribe_actor(&counting_actor_t::on_request);
+            p.subscribe_actor(&counting_actor_t::on_response);
+        });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        request<counted_req_t>(address, 4).send(rt::default_timeout);
+    }
+
+    void on_request(counted_traits_t::request::message_t &msg) noexcept {
+        auto res = make_response(msg, 5);
+        if (keep_response) {
+            kept_res.reset(static_cast<counted_traits_t::response::message_t *>(res.get()));
+        }
+        supervisor->put(std::move(res));
+    }
+
+    void on_response(counted_traits_t::response::message_t &msg) noexcept {
+        res_val += msg.payload.res.value;
+        res_address = msg.address;
+    }
+
+    void shutdown_finish() noexcept override {
+        kept_res.reset();
+        r::actor_base_t::shutdown_finish();
+    }
+};
+
 TEST_CASE("request-response successfull delivery", "[actor]") {
     r::system_context_t system_context;
 
@@ -765,3 +880,144 @@ TEST_CASE("request timer should not outlive requestee", "[actor]") {
     sup->do_process();
     REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
 }
+
+TEST_CASE("response re-addressing", "[actor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto actor = sup->create_actor<counting_actor_t>().timeout(rt::default_timeout).finish();
+    counted_res_t::copies = 0;
+
+    SECTION("exclusively owned response is not copied") { sup->do_process(); }
+
+    SECTION("shared response is copied") {
+        actor->keep_response = true;
+        sup->do_process();
+        CHECK(counted_res_t::copies == 1);
+        CHECK(actor->kept_res->address != actor->get_address());
+    }
+
+    CHECK(actor->res_val == 5);
+    CHECK(actor->res_address == actor->get_address());
+    CHECK(sup->get_requests().size() == 0);
+    if (!actor->keep_response) {
+        CHECK(counted_res_t::copies == 0);
+    }
+
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("auto cancellation", "[actor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto responder = sup->create_actor<tracking_responder_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+
+    auto requester = sup->create_actor<cancelling_requester_t>().timeout(rt::default_timeout).finish();
+    requester->responder = responder->get_address();
+
+    SECTION("timeout") {
+        sup->do_process();
+        REQUIRE(responder->req);
+        CHECK(responder->inflight.wanted(responder->req->payload));
+        REQUIRE(sup->active_timers.size() == 1);
+
+        sup->do_invoke_timer(sup->get_timer(0));
+        sup->do_process();
+        CHECK(requester->responses == 1);
+        REQUIRE(requester->ee);
+        CHECK(requester->ee->ec == r::error_code_t::request_timeout);
+        CHECK(responder->cancellations == 1);
+        CHECK(!responder->inflight.wanted(responder->req->payload));
+        CHECK(responder->inflight.empty());
+
+        /* the work is aborted, no reply */
+        responder->do_reply();
+        sup->do_process();
+        CHECK(requester->responses == 1);
+    }
+
+    SECTION("no auto-cancellation") {
+        requester->auto_cancel = false;
+        sup->do_process();
+        sup->do_invoke_timer(sup->get_timer(0));
+        sup->do_process();
+        CHECK(requester->responses == 1);
+        CHECK(responder->cancellations == 0);
+        CHECK(responder->inflight.size() == 1);
+    }
+
+    SECTION("replied") {
+        sup->do_process();
+        responder->do_reply();
+        sup->do_process();
+        CHECK(requester->responses == 1);
+        CHECK(!requester->ee);
+        CHECK(responder->cancellations == 0);
+        CHECK(responder->inflight.empty());
+    }
+
+    SECTION("requester shutdown") {
+        sup->do_process();
+        requester->do_shutdown();
+        sup->do_process();
+        CHECK(requester->responses == 0);
+        CHECK(responder->cancellations == 1);
+        CHECK(responder->inflight.empty());
+    }
+
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+    REQUIRE(sup->get_requests().size() == 0);
+    REQUIRE(sup->active_timers.size() == 0);
+}
+
+TEST_CASE("request table", "[actor]") {
+    r::request_table_t table;
+    auto actor = reinterpret_cast<r::actor_base_t *>(&table); /* never dereferenced */
+
+    auto &e1 = table.acquire();
+    auto &e2 = table.acquire();
+    auto id1 = e1.id;
+    auto id2 = e2.id;
+    CHECK(id1 != id2);
+    CHECK(!(id1 & r::request_table_t::timer_flag));
+    CHECK(table.size() == 2);
+
+    /* not sent yet */
+    CHECK(!table.find(id1));
+
+    e1.curry.source = actor;
+    e2.curry.source = actor;
+    CHECK(table.find(id1) == &e1);
+    CHECK(table.find(id2) == &e2);
+    CHECK(!table.find(id1 | r::request_table_t::timer_flag));
+
+    r::request_list_t list;
+    list.push(e1);
+    list.push(e2);
+    list.remove(e2);
+    CHECK(&list.front() == &e1);
+    list.remove(e1);
+    CHECK(list.empty());
+
+    table.release(e1);
+    CHECK(table.size() == 1);
+    CHECK(!table.find(id1));
+
+    /* the slot is reused with the new generation */
+    auto &e3 = table.acquire();
+    CHECK(&e3 == &e1);
+    CHECK(e3.id != id1);
+    e3.curry.source = actor;
+    CHECK(!table.find(id1));
+    CHECK(table.find(e3.id) == &e3);
+
+    table.release(e2);
+    table.release(e3);
+    CHECK(table.empty());
+}
@@ -69,3 +69,26 @@ TEST_CASE("lambda handler + interceptor", "[actor]") {
     REQUIRE(rt::empty(sup->get_subscription()));
     CHECK(intercepted);
 }
+
+TEST_CASE("lambda handler thunk", "[actor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+
+    int calls = 0;
+    auto handler = r::wrap_handler(*sup, r::lambda<message_t>([&](message_t &) noexcept { ++calls; }));
+    REQUIRE(handler->thunk);
+
+    r::message_ptr_t msg = r::make_message<payload>(sup->get_address(), nullptr);
+    handler->thunk(*handler, msg);
+    CHECK(calls == 1);
+
+    auto intercepted = handler->upgrade(my_tag);
+    CHECK(intercepted->thunk != handler->thunk);
+    handler.reset();
+
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+}
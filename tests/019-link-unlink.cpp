@@ -402,9 +402,8 @@ TEST_CASE("unlink notify / response race", "[actor]") {
     sup1->do_process();
 
     // extract unlink request to let it produce unlink notify
-    auto unlink_request = sup2->get_leader_queue().back();
+    auto unlink_request = sup2->get_leader_queue().pop_back();
     REQUIRE(unlink_request->type_index == r::message::unlink_request_t::message_type);
-    sup2->get_leader_queue().pop_back();
     sup2->do_process();
 
     sup1->do_shutdown();
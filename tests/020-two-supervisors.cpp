@@ -56,12 +56,20 @@ struct my_supervisor_t : public rt::supervisor_test_t {
         assert(state == r::state_t::SHUT_DOWN);
     }
 
+    void enqueue_batch(r::messages_queue_t &messages) noexcept override {
+        ++batches;
+        batched_messages += messages.size();
+        rt::supervisor_test_t::enqueue_batch(messages);
+    }
+
     ~my_supervisor_t() { ++destroyed; }
 
     std::uint32_t init_start_count = 0;
     std::uint32_t init_finish_count = 0;
     std::uint32_t shutdown_start_count = 0;
     std::uint32_t shutdown_finish_count = 0;
+    std::size_t batches = 0;
+    std::size_t batched_messages = 0;
 };
 
 TEST_CASE("two supervisors, different localities, shutdown 2nd", "[supervisor]") {
@@ -254,8 +262,7 @@ TEST_CASE("two supervisors & external subscription", "[supervisor]") {
         CHECK(sup1->get_state() == r::state_t::OPERATIONAL);
         CHECK(sup2->get_state() == r::state_t::SHUT_DOWN);
 
-        auto msg = sup1->get_leader_queue().front();
-        sup1->get_leader_queue().pop_front();
+        auto msg = sup1->get_leader_queue().pop_front();
         process();
 
         sup1->send<rt::payload::sample_t>(sup1->get_address(), 5);
@@ -270,6 +277,75 @@ TEST_CASE("two supervisors & external subscription", "[supervisor]") {
     CHECK(sup2->get_state() == r::state_t::SHUT_DOWN);
 }
 
+TEST_CASE("two supervisors & coalesced external delivery", "[supervisor]") {
+    rt::system_test_context_t ctx1;
+    rt::system_test_context_t ctx2;
+
+    int received = 0;
+    auto sup1 = ctx1.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto sup2 = ctx2.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto configurer = [&](auto &, r::plugin::plugin_base_t &plugin) {
+        plugin.with_casted<r::plugin::starter_plugin_t>([&](auto &p) {
+            using message_t = rt::message::sample_t;
+            p.subscribe_actor(r::lambda<message_t>([&](message_t &) noexcept { ++received; }), sup1->get_address());
+        });
+    };
+    std::vector<r::intrusive_ptr_t<rt::actor_test_t>> actors;
+    for (int i = 0; i < 3; ++i) {
+        auto act = sup2->create_actor<rt::actor_test_t>().timeout(rt::default_timeout).finish();
+        act->configurer = configurer;
+        actors.push_back(act);
+    }
+
+    auto process = [&]() {
+        while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+            sup1->do_process();
+            sup2->do_process();
+        }
+    };
+    process();
+    REQUIRE(sup1->get_state() == r::state_t::OPERATIONAL);
+    REQUIRE(sup2->get_state() == r::state_t::OPERATIONAL);
+
+    sup1->send<rt::payload::sample_t>(sup1->get_address(), 5);
+    sup1->do_process();
+    auto &queue2 = sup2->get_leader_queue();
+    REQUIRE(queue2.size() == 1);
+    auto call = dynamic_cast<r::message::multi_handler_call_t *>(&queue2.front());
+    REQUIRE(call);
+    auto &targets = call->payload.targets;
+    CHECK(targets.size() == 3);
+    for (auto &target : targets) {
+        REQUIRE(target.subscription);
+        CHECK(target.subscription->is_live());
+    }
+
+    SECTION("all handlers are invoked") {
+        process();
+        CHECK(received == 3);
+    }
+
+    SECTION("unsubscribed handler is skipped") {
+        auto msg = queue2.pop_front();
+        auto stale = static_cast<r::message::multi_handler_call_t *>(msg.get())->payload.targets.front();
+        auto actor = stale.handler->actor_ptr;
+        actor->do_shutdown();
+        process();
+        CHECK(!stale.subscription->is_live());
+
+        queue2.push_back(std::move(msg));
+        process();
+        CHECK(received == 2);
+    }
+
+    sup2->do_shutdown();
+    process();
+    sup1->do_shutdown();
+    process();
+    CHECK(sup1->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup2->get_state() == r::state_t::SHUT_DOWN);
+}
+
 TEST_CASE("two supervisors, same locality", "[supervisor]") {
     r::system_context_ptr_t system_context = new r::system_context_t();
 
@@ -410,3 +486,149 @@ TEST_CASE("message arrival order", "[supervisor]") {
     REQUIRE(sup1->get_state() == r::state_t::SHUT_DOWN);
     REQUIRE(sup2->get_state() == r::state_t::SHUT_DOWN);
 }
+
+TEST_CASE("two supervisors, different localities, hybrid refcount", "[supervisor]") {
+    r::system_context_t system_context;
+
+    const char locality1[] = "abc";
+    const char locality2[] = "def";
+    auto sup1 = system_context.create_supervisor<my_supervisor_t>()
+                    .locality(locality1)
+                    .timeout(rt::default_timeout)
+                    .hybrid_refcount()
+                    .finish();
+    auto sup2 = sup1->create_actor<my_supervisor_t>()
+                    .locality(locality2)
+                    .timeout(rt::default_timeout)
+                    .hybrid_refcount()
+                    .finish();
+
+    auto local = sup1->make_local_message<rt::payload::sample_t>(sup1->get_address(), 0);
+    CHECK(!local->is_shared());
+    CHECK(local->use_count() == 1);
+    auto copy = r::message_ptr_t(local);
+    CHECK(local->use_count() == 2);
+    copy.reset();
+    local->share();
+    CHECK(local->is_shared());
+    CHECK(local->use_count() == 1);
+
+    auto &queue2 = sup2->get_leader_queue();
+    auto own_messages = queue2.size();
+    sup1->do_process();
+    REQUIRE(queue2.size() > own_messages);
+    r::messages_queue_t tmp;
+    for (size_t i = 0; !queue2.empty(); ++i) {
+        auto message = queue2.pop_front();
+        if (i >= own_messages) {
+            CHECK(message->is_shared());
+        }
+        tmp.push_back(std::move(message));
+    }
+    queue2.splice_back(tmp);
+
+    while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+        sup1->do_process();
+        sup2->do_process();
+    }
+    REQUIRE(sup1->get_state() == r::state_t::OPERATIONAL);
+    REQUIRE(sup2->get_state() == r::state_t::OPERATIONAL);
+
+    sup1->do_shutdown();
+    while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+        sup1->do_process();
+        sup2->do_process();
+    }
+    CHECK(sup1->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup2->get_state() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("two supervisors, different localities, batched forwarding", "[supervisor]") {
+    r::system_context_t system_context;
+
+    const char locality1[] = "abc";
+    const char locality2[] = "def";
+    auto sup1 =
+        system_context.create_supervisor<my_supervisor_t>().locality(locality1).timeout(rt::default_timeout).finish();
+    auto sup2 = sup1->create_actor<my_supervisor_t>().locality(locality2).timeout(rt::default_timeout).finish();
+
+    while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+        sup1->do_process();
+        sup2->do_process();
+    }
+    REQUIRE(sup1->get_state() == r::state_t::OPERATIONAL);
+    REQUIRE(sup2->get_state() == r::state_t::OPERATIONAL);
+
+    auto batches = sup2->batches;
+    auto batched_messages = sup2->batched_messages;
+    auto &queue2 = sup2->get_leader_queue();
+    for (int i = 0; i < 3; ++i) {
+        sup1->send<rt::payload::sample_t>(sup2->get_address(), i);
+    }
+    CHECK(sup1->do_process() == 3);
+    CHECK(sup2->batches == batches + 1);
+    CHECK(sup2->batched_messages == batched_messages + 3);
+    REQUIRE(queue2.size() == 3);
+    for (int i = 0; i < 3; ++i) {
+        auto message = queue2.pop_front();
+        CHECK(static_cast<rt::message::sample_t *>(message.get())->payload.value == i);
+    }
+
+    sup1->do_shutdown();
+    while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+        sup1->do_process();
+        sup2->do_process();
+    }
+    CHECK(sup1->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup2->get_state() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("two supervisors, different localities, direct & external delivery order", "[supervisor]") {
+    rt::system_test_context_t ctx1;
+    rt::system_test_context_t ctx2;
+
+    using message_t = rt::message::sample_t;
+    std::vector<int> received;
+    auto sup1 = ctx1.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto sup2 = ctx2.create_supervisor<rt::supervisor_test_t>()
+                    .configurer([&](auto &, r::plugin::plugin_base_t &plugin) {
+                        plugin.with_casted<r::plugin::starter_plugin_t>([&](auto &p) {
+                            auto lambda = r::lambda<message_t>(
+                                [&](message_t &msg) noexcept { received.push_back(msg.payload.value); });
+                            p.subscribe_actor(lambda);
+                            p.subscribe_actor(lambda, sup1->get_address());
+                        });
+                    })
+                    .timeout(rt::default_timeout)
+                    .finish();
+
+    auto process = [&]() {
+        while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+            sup1->do_process();
+            sup2->do_process();
+        }
+    };
+    process();
+    REQUIRE(sup1->get_state() == r::state_t::OPERATIONAL);
+    REQUIRE(sup2->get_state() == r::state_t::OPERATIONAL);
+
+    sup1->send<rt::payload::sample_t>(sup2->get_address(), 1);
+    sup1->send<rt::payload::sample_t>(sup1->get_address(), 2);
+    sup1->send<rt::payload::sample_t>(sup2->get_address(), 3);
+    sup1->do_process();
+
+    auto &queue2 = sup2->get_leader_queue();
+    REQUIRE(queue2.size() == 3);
+    CHECK(dynamic_cast<message_t *>(&queue2.front()));
+    CHECK(dynamic_cast<message_t *>(&queue2.back()));
+
+    process();
+    CHECK(received == std::vector<int>{1, 2, 3});
+
+    sup2->do_shutdown();
+    process();
+    sup1->do_shutdown();
+    process();
+    CHECK(sup1->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup2->get_state() == r::state_t::SHUT_DOWN);
+}
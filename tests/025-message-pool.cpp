@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "catch.hpp"
+#include "rotor.hpp"
+#include "supervisor_test.h"
+#include <thread>
+#include <vector>
+
+namespace r = rotor;
+namespace rt = r::test;
+
+struct small_t {
+    int value;
+};
+
+struct big_t {
+    char data[r::message_pool_t::max_size];
+};
+
+struct ping_t {};
+struct pong_t {};
+
+struct pinger_t : public r::actor_base_t {
+    std::uint32_t pings_left = 0;
+    std::uint32_t pong_received = 0;
+
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&pinger_t::on_pong); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        do_send();
+    }
+
+    void on_pong(r::message_t<pong_t> &) noexcept {
+        ++pong_received;
+        do_send();
+    }
+
+    void do_send() noexcept {
+        if (pings_left) {
+            --pings_left;
+            send<ping_t>(ponger_addr);
+        }
+    }
+
+    r::address_ptr_t ponger_addr;
+};
+
+struct ponger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&ponger_t::on_ping); });
+    }
+
+    void on_ping(r::message_t<ping_t> &) noexcept { send<pong_t>(pinger_addr); }
+
+    r::address_ptr_t pinger_addr;
+};
+
+TEST_CASE("message pool allocations", "[message_pool]") {
+    r::message_pool_ptr_t pool{new r::message_pool_t()};
+    r::address_ptr_t addr;
+    auto &stats = pool->get_stats();
+
+    auto msg = r::message_ptr_t{r::make_pooled_message<small_t>(*pool, addr, 5)};
+    CHECK(static_cast<r::message_t<small_t> *>(msg.get())->payload.value == 5);
+    CHECK(msg->pooled);
+    CHECK(reinterpret_cast<std::uintptr_t>(msg.get()) % alignof(std::max_align_t) == 0);
+    CHECK(stats.hits == 0);
+    CHECK(stats.misses == 1);
+    auto held = stats.bytes_held;
+    CHECK(held > 0);
+
+    msg.reset();
+    msg.reset(r::make_pooled_message<small_t>(*pool, addr, 6));
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 1);
+    CHECK(stats.bytes_held == held);
+
+    SECTION("oversized messages are allocated on heap") {
+        auto big = r::message_ptr_t{r::make_pooled_message<big_t>(*pool, addr)};
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 2);
+        CHECK(stats.bytes_held == held);
+    }
+
+    SECTION("messages do not hold references to the pool") { CHECK(pool->use_count() == 1); }
+
+    SECTION("pool outlives its messages") {
+        auto msg_2 = r::message_ptr_t{r::make_pooled_message<small_t>(*pool, addr, 7)};
+        pool.reset();
+        msg.reset();
+        msg_2.reset();
+    }
+}
+
+TEST_CASE("message pool releases from other localities", "[message_pool]") {
+    static constexpr std::size_t count = 1000;
+    r::message_pool_ptr_t pool{new r::message_pool_t()};
+    r::message_pool_ptr_t other_pool{new r::message_pool_t()};
+    r::address_ptr_t addr;
+    auto &stats = pool->get_stats();
+
+    std::vector<r::message_ptr_t> messages;
+    messages.reserve(count);
+
+    /* the thread executes the locality context first, e.g. as asio strand does */
+    std::thread thread([&]() {
+        r::message_pool_t::context_t context{pool.get()};
+        r::message_ptr_t{r::make_pooled_message<small_t>(*pool, addr, 0)};
+    });
+    thread.join();
+    CHECK(stats.misses == 1);
+
+    r::message_pool_t::context_t context{pool.get()};
+    for (std::size_t i = 0; i < count; ++i) {
+        messages.emplace_back(r::make_pooled_message<small_t>(*pool, addr, static_cast<int>(i)));
+    }
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == count);
+
+    /* now the former thread executes other locality context, and releases messages from it */
+    thread = std::thread([&]() {
+        r::message_pool_t::context_t context{other_pool.get()};
+        messages.clear();
+    });
+    for (std::size_t i = 0; i < count; ++i) {
+        r::message_ptr_t{r::make_pooled_message<small_t>(*pool, addr, static_cast<int>(i))};
+    }
+    thread.join();
+
+    auto hits = stats.hits;
+    auto misses = stats.misses;
+    CHECK(hits + misses == 2 * count + 1);
+    for (std::size_t i = 0; i < count; ++i) {
+        messages.emplace_back(r::make_pooled_message<small_t>(*pool, addr, static_cast<int>(i)));
+    }
+    CHECK(stats.hits == hits + count);
+    CHECK(stats.misses == misses);
+}
+
+TEST_CASE("unpooled messages", "[message_pool]") {
+    r::address_ptr_t addr;
+    auto msg = r::make_message<small_t>(addr, 7);
+    CHECK(static_cast<r::message_t<small_t> *>(msg.get())->payload.value == 7);
+    CHECK(!msg->pooled);
+}
+
+TEST_CASE("ping-pong via message pool", "[message_pool]") {
+    r::system_context_t system_context;
+    const char locality[] = "abc";
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>()
+                   .locality(locality)
+                   .timeout(rt::default_timeout)
+                   .message_pool()
+                   .finish();
+    auto sup_child = sup->create_actor<rt::supervisor_test_t>()
+                         .locality(locality)
+                         .timeout(rt::default_timeout)
+                         .message_pool()
+                         .finish();
+    auto pinger = sup->create_actor<pinger_t>().timeout(rt::default_timeout).finish();
+    auto ponger = sup_child->create_actor<ponger_t>().timeout(rt::default_timeout).finish();
+
+    pinger->ponger_addr = ponger->get_address();
+    ponger->pinger_addr = pinger->get_address();
+    pinger->pings_left = 10;
+
+    auto pool = sup->get_message_pool();
+    REQUIRE(pool);
+
+    sup->do_process();
+    CHECK(sup_child->get_message_pool() == pool);
+    CHECK(pool->use_count() == 2);
+    CHECK(pinger->pong_received == 10);
+
+    auto &stats = pool->get_stats();
+    CHECK(stats.hits >= 18);
+    CHECK(stats.bytes_held > 0);
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("message pool is disabled by default", "[message_pool]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    CHECK(!sup->get_message_pool());
+    sup->do_process();
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+}
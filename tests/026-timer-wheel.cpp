@@ -0,0 +1,210 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "catch.hpp"
+#include "rotor.hpp"
+#include "supervisor_test.h"
+#include "access.h"
+#include <vector>
+
+namespace r = rotor;
+namespace rt = r::test;
+
+using wheel_t = r::timer_wheel_t;
+
+struct sample_node_t : wheel_t::node_t {
+    std::uint64_t fired_at = 0;
+};
+
+static void advance(wheel_t &wheel, std::uint64_t ticks) {
+    for (std::uint64_t i = 0; i < ticks; ++i) {
+        wheel.tick([&](wheel_t::node_t &node) { static_cast<sample_node_t &>(node).fired_at = wheel.now(); });
+    }
+}
+
+struct request_sample_t {
+    using response_t = int;
+    int value;
+};
+
+using traits_t = r::request_traits_t<request_sample_t>;
+
+struct requester_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    r::pt::time_duration request_timeout;
+    r::address_ptr_t responder;
+    r::extended_error_ptr_t ee;
+    int responses = 0;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&requester_t::on_response); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        request<request_sample_t>(responder, 1).send(request_timeout);
+    }
+
+    void on_response(traits_t::response::message_t &msg) noexcept {
+        ++responses;
+        ee = msg.payload.ee;
+    }
+};
+
+struct responder_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    bool reply = true;
+    r::intrusive_ptr_t<traits_t::request::message_t> req_msg;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&responder_t::on_request); });
+    }
+
+    void shutdown_start() noexcept override {
+        req_msg.reset();
+        r::actor_base_t::shutdown_start();
+    }
+
+    void on_request(traits_t::request::message_t &msg) noexcept {
+        if (reply) {
+            reply_to(msg, 2);
+        } else {
+            req_msg.reset(&msg);
+        }
+    }
+};
+
+TEST_CASE("timer wheel", "[timer]") {
+    wheel_t wheel;
+    CHECK(wheel.empty());
+
+    SECTION("expiration ticks") {
+        std::vector<std::uint64_t> delays = {1, 2, 63, 64, 65, 127, 128, 4095, 4096, 4097, 262143, 262144, 300000};
+        std::vector<sample_node_t> nodes(delays.size());
+        for (std::size_t i = 0; i < delays.size(); ++i) {
+            wheel.arm(nodes[i], delays[i]);
+        }
+        CHECK(wheel.size() == delays.size());
+
+        advance(wheel, 300000);
+        CHECK(wheel.empty());
+        for (std::size_t i = 0; i < delays.size(); ++i) {
+            CHECK(nodes[i].fired_at == delays[i]);
+            CHECK(!nodes[i].armed());
+        }
+    }
+
+    SECTION("arming in the middle") {
+        advance(wheel, 100);
+        sample_node_t node;
+        wheel.arm(node, 5000);
+        advance(wheel, 4999);
+        CHECK(node.fired_at == 0);
+        advance(wheel, 1);
+        CHECK(node.fired_at == 5100);
+    }
+
+    SECTION("beyond the wheel range") {
+        std::uint64_t delay = (std::uint64_t{1} << (wheel_t::level_bits * wheel_t::levels)) + 17;
+        sample_node_t node;
+        wheel.arm(node, delay);
+        advance(wheel, delay - 1);
+        CHECK(node.fired_at == 0);
+        advance(wheel, 1);
+        CHECK(node.fired_at == delay);
+    }
+
+    SECTION("cancellation") {
+        sample_node_t n1, n2, n3;
+        wheel.arm(n1, 3);
+        wheel.arm(n2, 3);
+        wheel.arm(n3, 70);
+        wheel.cancel(n2);
+        wheel.cancel(n3);
+        CHECK(wheel.size() == 1);
+        CHECK(!n2.armed());
+
+        advance(wheel, 100);
+        CHECK(n1.fired_at == 3);
+        CHECK(n2.fired_at == 0);
+        CHECK(n3.fired_at == 0);
+        CHECK(wheel.empty());
+    }
+}
+
+TEST_CASE("request timeouts via timer wheel", "[timer]") {
+    r::system_context_t system_context;
+    auto tick = r::pt::milliseconds{1};
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>()
+                   .timeout(rt::default_timeout)
+                   .request_wheel_tick(tick)
+                   .finish();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::OPERATIONAL);
+
+    /* initialization requests are tracked by wheel, only tick timer remains */
+    REQUIRE(sup->active_timers.size() == 1);
+    sup->do_invoke_timer(sup->get_timer(0));
+    REQUIRE(sup->active_timers.size() == 0);
+
+    auto responder = sup->create_actor<responder_t>().timeout(rt::default_timeout).finish();
+    auto requester = sup->create_actor<requester_t>().timeout(rt::default_timeout).finish();
+    requester->responder = responder->get_address();
+    requester->request_timeout = r::pt::milliseconds{5};
+
+    SECTION("response in time") {
+        sup->do_process();
+        CHECK(requester->responses == 1);
+        CHECK(!requester->ee);
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    SECTION("timeout") {
+        responder->reply = false;
+        sup->do_process();
+        CHECK(requester->responses == 0);
+        CHECK(sup->get_requests().size() == 1);
+        REQUIRE(sup->active_timers.size() == 1);
+
+        /* the same periodic timer is re-armed on every tick */
+        auto tick_timer = sup->get_timer(0);
+        int ticks = 0;
+        while (!requester->responses) {
+            REQUIRE(sup->active_timers.size() == 1);
+            REQUIRE(sup->get_timer(0) == tick_timer);
+            sup->do_invoke_timer(tick_timer);
+            sup->do_process();
+            ++ticks;
+        }
+        CHECK(ticks >= 5);
+        CHECK(ticks <= 6);
+        REQUIRE(requester->ee);
+        CHECK(requester->ee->ec == r::error_code_t::request_timeout);
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    SECTION("requester shutdown cancels pending request") {
+        responder->reply = false;
+        sup->do_process();
+        CHECK(sup->get_requests().size() == 1);
+
+        requester->do_shutdown();
+        sup->do_process();
+        CHECK(requester->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+        CHECK(requester->responses == 0);
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+    REQUIRE(sup->get_requests().size() == 0);
+    REQUIRE(sup->active_timers.size() == 0);
+}
@@ -0,0 +1,244 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "catch.hpp"
+#include "rotor.hpp"
+#include "supervisor_test.h"
+#include "access.h"
+
+namespace r = rotor;
+namespace rt = r::test;
+
+struct response_sample_t {
+    int value;
+};
+
+struct request_sample_t {
+    using response_t = response_sample_t;
+    int value;
+};
+
+using traits_t = r::request_traits_t<request_sample_t>;
+
+struct shard_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    int factor = 1;
+    bool reply = true;
+    int cancelled = 0;
+    r::intrusive_ptr_t<traits_t::request::message_t> req_msg;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) {
+            p.subscribe_actor(&shard_t::on_request);
+            p.subscribe_actor(&shard_t::on_cancel);
+        });
+    }
+
+    void shutdown_start() noexcept override {
+        req_msg.reset();
+        r::actor_base_t::shutdown_start();
+    }
+
+    void on_request(traits_t::request::message_t &msg) noexcept {
+        if (reply) {
+            reply_to(msg, msg.payload.request_payload.value * factor);
+        } else {
+            req_msg.reset(&msg);
+        }
+    }
+
+    void on_cancel(traits_t::cancel::message_t &msg) noexcept {
+        if (req_msg && req_msg->payload.id == msg.payload.id) {
+            ++cancelled;
+        }
+    }
+};
+
+struct gatherer_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    r::addresses_t shards;
+    r::address_ptr_t reply_to;
+    std::size_t quorum = 0;
+    r::request_id_t request_id = 0;
+    int replies = 0;
+    r::intrusive_ptr_t<traits_t::gather::message_t> reply;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&gatherer_t::on_gather); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        if (shards.empty()) {
+            return;
+        }
+        auto builder = reply_to ? supervisor->do_scatter<request_sample_t>(*this, shards, reply_to, 2)
+                                : scatter<request_sample_t>(shards, 2);
+        if (quorum) {
+            builder.quorum(quorum);
+        }
+        request_id = builder.send(rt::default_timeout);
+    }
+
+    void on_gather(traits_t::gather::message_t &msg) noexcept {
+        ++replies;
+        reply.reset(&msg);
+    }
+};
+
+TEST_CASE("scatter-gather", "[actor]") {
+    r::system_context_t system_context;
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+
+    std::vector<r::intrusive_ptr_t<shard_t>> shards;
+    auto gatherer = sup->create_actor<gatherer_t>().timeout(rt::default_timeout).finish();
+    for (int i = 1; i <= 3; ++i) {
+        auto shard = sup->create_actor<shard_t>().timeout(rt::default_timeout).finish();
+        shard->factor = i;
+        gatherer->shards.emplace_back(shard->get_address());
+        shards.emplace_back(std::move(shard));
+    }
+
+    SECTION("all replies") {
+        sup->do_process();
+        REQUIRE(gatherer->replies == 1);
+        auto &payload = gatherer->reply->payload;
+        CHECK(payload.id == gatherer->request_id);
+        CHECK(!payload.ee);
+        CHECK(payload.replied == 3);
+        REQUIRE(payload.responses.size() == 3);
+        for (std::size_t i = 0; i < 3; ++i) {
+            REQUIRE(payload.responses[i]);
+            CHECK(payload.responses[i]->payload.res.value == 2 * static_cast<int>(i + 1));
+        }
+        CHECK(sup->active_timers.size() == 0);
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    SECTION("quorum") {
+        gatherer->quorum = 2;
+        shards[1]->reply = false;
+        sup->do_process();
+        REQUIRE(gatherer->replies == 1);
+        auto &payload = gatherer->reply->payload;
+        CHECK(!payload.ee);
+        CHECK(payload.replied == 2);
+        CHECK(payload.responses[0]);
+        CHECK(!payload.responses[1]);
+        CHECK(payload.responses[2]);
+        CHECK(shards[1]->cancelled == 1);
+        CHECK(sup->active_timers.size() == 0);
+        CHECK(sup->get_requests().size() == 0);
+
+        SECTION("late reply is dropped") {
+            shards[1]->reply_to(*shards[1]->req_msg, 5);
+            sup->do_process();
+            CHECK(gatherer->replies == 1);
+        }
+    }
+
+    SECTION("timeout") {
+        shards[0]->reply = false;
+        shards[2]->reply = false;
+        sup->do_process();
+        CHECK(gatherer->replies == 0);
+        REQUIRE(sup->active_timers.size() == 1);
+
+        sup->do_invoke_timer(sup->get_timer(0));
+        sup->do_process();
+        REQUIRE(gatherer->replies == 1);
+        auto &payload = gatherer->reply->payload;
+        REQUIRE(payload.ee);
+        CHECK(payload.ee->ec == r::error_code_t::request_timeout);
+        CHECK(payload.replied == 1);
+        CHECK(!payload.responses[0]);
+        CHECK(payload.responses[1]);
+        CHECK(!payload.responses[2]);
+        CHECK(shards[0]->cancelled == 1);
+        CHECK(shards[1]->cancelled == 0);
+        CHECK(shards[2]->cancelled == 1);
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    SECTION("requester shutdown") {
+        for (auto &shard : shards) {
+            shard->reply = false;
+        }
+        sup->do_process();
+        CHECK(sup->get_requests().size() == 1);
+
+        gatherer->do_shutdown();
+        sup->do_process();
+        CHECK(gatherer->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+        CHECK(gatherer->replies == 0);
+        for (auto &shard : shards) {
+            CHECK(shard->cancelled == 1);
+        }
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+    REQUIRE(sup->active_timers.size() == 0);
+}
+
+TEST_CASE("scatter-gather, reply to other locality, hybrid refcount", "[actor]") {
+    r::system_context_t system_context;
+
+    const char locality1[] = "abc";
+    const char locality2[] = "def";
+    auto sup1 = system_context.create_supervisor<rt::supervisor_test_t>()
+                    .locality(locality1)
+                    .timeout(rt::default_timeout)
+                    .hybrid_refcount()
+                    .finish();
+    auto sup2 = sup1->create_actor<rt::supervisor_test_t>()
+                    .locality(locality2)
+                    .timeout(rt::default_timeout)
+                    .hybrid_refcount()
+                    .finish();
+
+    auto process = [&]() {
+        while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+            sup1->do_process();
+            sup2->do_process();
+        }
+    };
+
+    auto receiver = sup2->create_actor<gatherer_t>().timeout(rt::default_timeout).finish();
+    process();
+    REQUIRE(receiver->access<rt::to::state>() == r::state_t::OPERATIONAL);
+
+    auto gatherer = sup1->create_actor<gatherer_t>().timeout(rt::default_timeout).finish();
+    gatherer->reply_to = receiver->get_address();
+    for (int i = 1; i <= 3; ++i) {
+        auto shard = sup1->create_actor<shard_t>().timeout(rt::default_timeout).finish();
+        shard->factor = i;
+        gatherer->shards.emplace_back(shard->get_address());
+    }
+    process();
+    CHECK(gatherer->replies == 0);
+    REQUIRE(receiver->replies == 1);
+    auto &payload = receiver->reply->payload;
+    CHECK(payload.replied == 3);
+    for (std::size_t i = 0; i < 3; ++i) {
+        REQUIRE(payload.responses[i]);
+        CHECK(payload.responses[i]->is_shared());
+        CHECK(payload.responses[i]->payload.res.value == 2 * static_cast<int>(i + 1));
+    }
+    receiver->reply.reset();
+
+    sup1->do_shutdown();
+    process();
+    CHECK(sup1->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup2->get_state() == r::state_t::SHUT_DOWN);
+}
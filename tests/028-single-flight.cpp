@@ -0,0 +1,272 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "catch.hpp"
+#include "rotor.hpp"
+#include "supervisor_test.h"
+#include "access.h"
+#include <string>
+#include <vector>
+
+namespace r = rotor;
+namespace rt = r::test;
+
+struct lookup_result_t : r::arc_base_t<lookup_result_t> {
+    std::string value;
+    explicit lookup_result_t(std::string value_) : value{std::move(value_)} {}
+};
+
+struct lookup_t {
+    using response_t = r::intrusive_ptr_t<lookup_result_t>;
+    std::string key;
+
+    bool operator==(const lookup_t &other) const noexcept { return key == other.key; }
+};
+
+namespace std {
+template <> struct hash<lookup_t> {
+    std::size_t operator()(const lookup_t &lookup) const noexcept { return std::hash<std::string>()(lookup.key); }
+};
+} // namespace std
+
+using traits_t = r::request_traits_t<lookup_t>;
+
+struct service_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    std::vector<r::intrusive_ptr_t<traits_t::request::message_t>> requests;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&service_t::on_request); });
+    }
+
+    void shutdown_start() noexcept override {
+        requests.clear();
+        r::actor_base_t::shutdown_start();
+    }
+
+    void on_request(traits_t::request::message_t &msg) noexcept { requests.emplace_back(&msg); }
+
+    void reply_all() noexcept {
+        for (auto &req : requests) {
+            reply_to(*req, "value-of-" + req->payload.request_payload.key);
+        }
+        requests.clear();
+    }
+};
+
+struct client_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    r::address_ptr_t service;
+    std::string key = "k";
+    bool coalesce = true;
+    r::request_id_t request_id = 0;
+    r::intrusive_ptr_t<traits_t::response::message_t> reply;
+    int responses = 0;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&client_t::on_response); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        request_id = request<lookup_t>(service, key).coalesce(coalesce).send(rt::default_timeout);
+    }
+
+    void on_response(traits_t::response::message_t &msg) noexcept {
+        ++responses;
+        reply.reset(&msg);
+    }
+};
+
+TEST_CASE("single-flight requests", "[actor]") {
+    r::system_context_t system_context;
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto service = sup->create_actor<service_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+    REQUIRE(sup->active_timers.size() == 0);
+
+    std::vector<r::intrusive_ptr_t<client_t>> clients;
+    auto add_client = [&](std::string key, bool coalesce = true) {
+        auto client = sup->create_actor<client_t>().timeout(rt::default_timeout).finish();
+        client->service = service->get_address();
+        client->key = std::move(key);
+        client->coalesce = coalesce;
+        clients.emplace_back(client);
+    };
+
+    SECTION("identical requests are coalesced") {
+        add_client("k");
+        add_client("k");
+        add_client("k");
+        sup->do_process();
+        REQUIRE(service->requests.size() == 1);
+        /* each joined request has own id and own timeout */
+        CHECK(sup->active_timers.size() == 3);
+        CHECK(sup->get_requests().size() == 3);
+        CHECK(clients[1]->request_id != clients[0]->request_id);
+        CHECK(clients[2]->request_id != clients[1]->request_id);
+
+        service->reply_all();
+        sup->do_process();
+        for (auto &client : clients) {
+            CHECK(client->responses == 1);
+            REQUIRE(client->reply);
+            CHECK(!client->reply->payload.ee);
+            CHECK(client->reply->payload.request_id() == client->request_id);
+            /* the response payload is shared */
+            CHECK(client->reply->payload.res == clients[0]->reply->payload.res);
+        }
+        CHECK(clients[0]->reply->payload.res->value == "value-of-k");
+        CHECK(sup->active_timers.size() == 0);
+        CHECK(sup->get_requests().size() == 0);
+
+        SECTION("new flight after reply") {
+            add_client("k");
+            sup->do_process();
+            CHECK(service->requests.size() == 1);
+            CHECK(clients.back()->request_id != clients[0]->request_id);
+            service->reply_all();
+            sup->do_process();
+            CHECK(clients.back()->responses == 1);
+            CHECK(clients[0]->responses == 1);
+        }
+    }
+
+    SECTION("different payloads are not coalesced") {
+        add_client("k1");
+        add_client("k2");
+        add_client("k1");
+        sup->do_process();
+        REQUIRE(service->requests.size() == 2);
+        CHECK(sup->active_timers.size() == 3);
+        service->reply_all();
+        sup->do_process();
+        CHECK(clients[0]->reply->payload.res->value == "value-of-k1");
+        CHECK(clients[1]->reply->payload.res->value == "value-of-k2");
+        CHECK(clients[2]->reply->payload.res->value == "value-of-k1");
+    }
+
+    SECTION("regular requests are not coalesced") {
+        add_client("k");
+        add_client("k", false);
+        add_client("k");
+        sup->do_process();
+        CHECK(service->requests.size() == 2);
+        service->reply_all();
+        sup->do_process();
+        for (auto &client : clients) {
+            CHECK(client->responses == 1);
+        }
+    }
+
+    SECTION("timeout of the request in flight") {
+        add_client("k");
+        add_client("k");
+        sup->do_process();
+        REQUIRE(sup->active_timers.size() == 2);
+        sup->do_invoke_timer(sup->get_timer(0));
+        sup->do_process();
+        CHECK(clients[0]->responses == 1);
+        REQUIRE(clients[0]->reply->payload.ee);
+        CHECK(clients[0]->reply->payload.ee->ec == r::error_code_t::request_timeout);
+
+        /* the joined request takes over the flight */
+        CHECK(clients[1]->responses == 0);
+        CHECK(service->requests.size() == 2);
+        CHECK(sup->get_requests().size() == 1);
+
+        /* late reply is dropped */
+        service->reply_all();
+        sup->do_process();
+        CHECK(clients[0]->responses == 1);
+        CHECK(clients[1]->responses == 1);
+        CHECK(!clients[1]->reply->payload.ee);
+        CHECK(clients[1]->reply->payload.request_id() == clients[1]->request_id);
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    SECTION("timeout of the joined request") {
+        add_client("k");
+        add_client("k");
+        sup->do_process();
+        REQUIRE(sup->active_timers.size() == 2);
+        sup->do_invoke_timer(sup->get_timer(1));
+        sup->do_process();
+        CHECK(clients[0]->responses == 0);
+        CHECK(clients[1]->responses == 1);
+        REQUIRE(clients[1]->reply->payload.ee);
+        CHECK(clients[1]->reply->payload.ee->ec == r::error_code_t::request_timeout);
+        CHECK(clients[1]->reply->payload.request_id() == clients[1]->request_id);
+        CHECK(sup->get_requests().size() == 1);
+
+        service->reply_all();
+        sup->do_process();
+        CHECK(clients[0]->responses == 1);
+        CHECK(!clients[0]->reply->payload.ee);
+        CHECK(clients[1]->responses == 1);
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    SECTION("original requester shutdown") {
+        add_client("k");
+        add_client("k");
+        add_client("k");
+        sup->do_process();
+        clients[0]->do_shutdown();
+        sup->do_process();
+        CHECK(clients[0]->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+        CHECK(clients[0]->responses == 0);
+
+        /* the flight is handed over to the first joined requester */
+        CHECK(clients[1]->responses == 0);
+        CHECK(clients[2]->responses == 0);
+        CHECK(service->requests.size() == 2);
+        CHECK(sup->get_requests().size() == 2);
+        CHECK(sup->active_timers.size() == 2);
+
+        service->reply_all();
+        sup->do_process();
+        for (std::size_t i = 1; i < clients.size(); ++i) {
+            auto &client = clients[i];
+            CHECK(client->responses == 1);
+            REQUIRE(client->reply);
+            CHECK(!client->reply->payload.ee);
+            CHECK(client->reply->payload.request_id() == client->request_id);
+        }
+        CHECK(sup->get_requests().size() == 0);
+        CHECK(sup->active_timers.size() == 0);
+    }
+
+    SECTION("joined requester shutdown") {
+        add_client("k");
+        add_client("k");
+        sup->do_process();
+        clients[1]->do_shutdown();
+        sup->do_process();
+        CHECK(clients[1]->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+        CHECK(sup->get_requests().size() == 1);
+        CHECK(sup->active_timers.size() == 1);
+
+        service->reply_all();
+        sup->do_process();
+        CHECK(clients[0]->responses == 1);
+        CHECK(clients[1]->responses == 0);
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    for (auto &client : clients) {
+        client->reply.reset();
+    }
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+    REQUIRE(sup->get_requests().size() == 0);
+    REQUIRE(sup->active_timers.size() == 0);
+}
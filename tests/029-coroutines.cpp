@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "catch.hpp"
+#include "rotor.hpp"
+#include "rotor/coro.hpp"
+#include "supervisor_test.h"
+#include "access.h"
+
+namespace r = rotor;
+namespace rt = r::test;
+
+struct response_sample_t {
+    int value;
+};
+
+struct request_sample_t {
+    using response_t = response_sample_t;
+    int value;
+};
+
+using traits_t = r::request_traits_t<request_sample_t>;
+
+struct service_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    bool reply = true;
+    int requests = 0;
+    r::intrusive_ptr_t<traits_t::request::message_t> req_msg;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&service_t::on_request); });
+        plugin.with_casted<r::plugin::registry_plugin_t>([&](auto &p) { p.register_name("service", get_address()); });
+    }
+
+    void shutdown_start() noexcept override {
+        req_msg.reset();
+        r::actor_base_t::shutdown_start();
+    }
+
+    void on_request(traits_t::request::message_t &msg) noexcept {
+        ++requests;
+        if (reply) {
+            reply_to(msg, msg.payload.request_payload.value * 2);
+        } else {
+            req_msg.reset(&msg);
+        }
+    }
+};
+
+struct guard_t {
+    int &destroyed;
+    ~guard_t() { ++destroyed; }
+};
+
+struct client_t : public r::coro::actor_t {
+    using r::coro::actor_t::actor_t;
+
+    r::address_ptr_t service;
+    int steps = 0;
+    int result = 0;
+    int destroyed = 0;
+    r::extended_error_ptr_t ee;
+
+    r::coro::task_t flow(int value) {
+        guard_t guard{destroyed};
+        auto discovery = co_await discover("service").send(rt::default_timeout);
+        if (discovery->payload.ee) {
+            ee = discovery->payload.ee;
+            co_return;
+        }
+        service = discovery->payload.res.service_addr;
+        ++steps;
+
+        auto response =
+            co_await co_request<request_sample_t>(service, value).send(rt::default_timeout).auto_cancel();
+        if (response->payload.ee) {
+            ee = response->payload.ee;
+            co_return;
+        }
+        result = response->payload.res.value;
+        ++steps;
+
+        co_await sleep(r::pt::milliseconds{10});
+        ++steps;
+    }
+};
+
+TEST_CASE("coroutines", "[actor]") {
+    r::system_context_t system_context;
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>()
+                   .timeout(rt::default_timeout)
+                   .create_registry()
+                   .finish();
+    auto service = sup->create_actor<service_t>().timeout(rt::default_timeout).finish();
+    auto client = sup->create_actor<client_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+    REQUIRE(client->access<rt::to::state>() == r::state_t::OPERATIONAL);
+    auto &handlers = sup->get_subscription().access<rt::to::mine_handlers>();
+
+    SECTION("request, sleep and discovery") {
+        client->flow(5);
+        sup->do_process();
+        CHECK(client->steps == 2);
+        CHECK(client->result == 10);
+        CHECK(client->service == service->get_address());
+        CHECK(client->destroyed == 0);
+        CHECK(sup->get_requests().size() == 0);
+
+        REQUIRE(sup->active_timers.size() == 1);
+        sup->do_invoke_timer(sup->get_timer(0));
+        CHECK(client->steps == 3);
+        CHECK(client->destroyed == 1);
+        CHECK(!client->ee);
+
+        /* the frame is cached by arena */
+        auto &arena = client->get_frame_arena();
+        CHECK(arena.cached() == 1);
+
+        SECTION("frame reuse") {
+            /* the response handlers are installed once per response type */
+            auto subscriptions = handlers.size();
+            client->flow(7);
+            CHECK(arena.cached() == 0);
+            sup->do_process();
+            CHECK(client->result == 14);
+            sup->do_invoke_timer(sup->get_timer(0));
+            CHECK(client->destroyed == 2);
+            CHECK(arena.cached() == 1);
+            CHECK(handlers.size() == subscriptions);
+        }
+    }
+
+    SECTION("request timeout") {
+        service->reply = false;
+        client->flow(5);
+        sup->do_process();
+        CHECK(client->steps == 1);
+        REQUIRE(sup->active_timers.size() == 1);
+        sup->do_invoke_timer(sup->get_timer(0));
+        REQUIRE(client->ee);
+        CHECK(client->ee->ec == r::error_code_t::request_timeout);
+        CHECK(client->destroyed == 1);
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    SECTION("abandoned on shutdown") {
+        SECTION("awaiting request") {
+            service->reply = false;
+            client->flow(5);
+            sup->do_process();
+            CHECK(sup->get_requests().size() == 1);
+        }
+        SECTION("awaiting timer") {
+            client->flow(5);
+            sup->do_process();
+            CHECK(sup->active_timers.size() == 1);
+        }
+        client->do_shutdown();
+        sup->do_process();
+        CHECK(client->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+        CHECK(client->destroyed == 1);
+        CHECK(!client->ee);
+        CHECK(sup->get_requests().size() == 0);
+    }
+
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+    REQUIRE(sup->get_requests().size() == 0);
+    REQUIRE(sup->active_timers.size() == 0);
+}
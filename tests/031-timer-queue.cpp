@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2019-2022 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "catch.hpp"
+#include "rotor.hpp"
+#include "rotor/timer_queue.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace r = rotor;
+
+using queue_t = r::timer_queue_t;
+using steady_clock_t = queue_t::clock_t;
+
+struct sample_handler_t : r::timer_handler_base_t {
+    using r::timer_handler_base_t::timer_handler_base_t;
+    void trigger(bool) noexcept override {}
+};
+
+using handler_ptr_t = std::unique_ptr<sample_handler_t>;
+
+static std::vector<r::request_id_t> drain(queue_t &queue, const steady_clock_t::time_point &now) {
+    std::vector<r::request_id_t> ids;
+    while (auto handler = queue.pop_expired(now)) {
+        ids.push_back(handler->request_id);
+    }
+    return ids;
+}
+
+TEST_CASE("timer queue", "[timer]") {
+    using namespace std::chrono_literals;
+    queue_t queue;
+    std::vector<handler_ptr_t> handlers;
+    for (r::request_id_t id = 1; id <= 10; ++id) {
+        handlers.emplace_back(std::make_unique<sample_handler_t>(nullptr, id));
+    }
+    auto base = steady_clock_t::now();
+    auto expired = base + 1h;
+
+    SECTION("expiration order") {
+        int offsets[] = {5, 3, 9, 1, 7, 2, 10, 4, 8, 6};
+        for (std::size_t i = 0; i < 10; ++i) {
+            queue.push(*handlers[i], base + std::chrono::milliseconds(offsets[i]));
+        }
+        CHECK(queue.size() == 10);
+        CHECK(queue.next_deadline() == base + 1ms);
+        CHECK(drain(queue, base + 1ms).empty());
+        CHECK(drain(queue, base + 3ms) == std::vector<r::request_id_t>{4, 6});
+        CHECK(drain(queue, expired) == std::vector<r::request_id_t>{2, 8, 1, 10, 5, 9, 3, 7});
+        CHECK(queue.empty());
+    }
+
+    SECTION("equal deadlines expire in arming order") {
+        for (std::size_t i = 10; i > 0; --i) {
+            queue.push(*handlers[i - 1], base);
+        }
+        CHECK(drain(queue, expired) == std::vector<r::request_id_t>{10, 9, 8, 7, 6, 5, 4, 3, 2, 1});
+    }
+
+    SECTION("removal") {
+        for (std::size_t i = 0; i < 10; ++i) {
+            queue.push(*handlers[i], base + std::chrono::milliseconds(i));
+        }
+        CHECK(queue.remove(*handlers[0]));
+        CHECK(queue.remove(*handlers[4]));
+        CHECK(queue.remove(*handlers[9]));
+        CHECK(!queue.remove(*handlers[4]));
+        CHECK(handlers[4]->heap_index == r::timer_handler_base_t::unlinked);
+        CHECK(queue.size() == 7);
+        CHECK(queue.next_deadline() == base + 1ms);
+        CHECK(drain(queue, expired) == std::vector<r::request_id_t>{2, 3, 4, 6, 7, 8, 9});
+    }
+
+    SECTION("slack") {
+        auto slack = std::chrono::milliseconds(10);
+        auto bucket = base - base.time_since_epoch() % slack + slack;
+        for (std::size_t i = 0; i < 9; ++i) {
+            queue.push(*handlers[i], bucket - std::chrono::microseconds(i * 100), slack);
+        }
+        queue.push(*handlers[9], bucket + 1ms, slack);
+        CHECK(queue.next_deadline() == bucket);
+        CHECK(drain(queue, bucket).empty());
+        CHECK(drain(queue, bucket + 1ns) == std::vector<r::request_id_t>{1, 2, 3, 4, 5, 6, 7, 8, 9});
+        CHECK(queue.next_deadline() == bucket + slack);
+    }
+}
@@ -16,3 +16,175 @@ TEST_CASE("error code messages", "[misc]") {
     CHECK(r::shutdown_code_category().name() == std::string("rotor_shutdown"));
     CHECK(r::shutdown_code_category().message(-1) == "unknown shutdown reason");
 }
+
+TEST_CASE("messages queue", "[misc]") {
+    struct sample_t {
+        int value;
+    };
+    using message_t = r::message_t<sample_t>;
+    auto value = [](const r::message_base_t &message) { return static_cast<const message_t &>(message).payload.value; };
+    r::address_ptr_t addr;
+
+    r::messages_queue_t q1;
+    CHECK(q1.empty());
+    q1.push_back(r::make_message<sample_t>(addr, 1));
+    q1.push_back(r::make_message<sample_t>(addr, 2));
+    q1.push_back(r::make_message<sample_t>(addr, 3));
+    CHECK(q1.size() == 3);
+    CHECK(value(q1.front()) == 1);
+    CHECK(value(q1.back()) == 3);
+
+    auto last = q1.pop_back();
+    CHECK(value(*last) == 3);
+    CHECK(last->use_count() == 1);
+    CHECK(value(q1.back()) == 2);
+
+    r::messages_queue_t q2;
+    q2.push_back(std::move(last));
+    q2.push_back(r::make_message<sample_t>(addr, 4));
+    q1.splice_back(q2);
+    CHECK(q2.empty());
+    CHECK(q2.size() == 0);
+    CHECK(q1.size() == 4);
+
+    for (int i = 1; i <= 4; ++i) {
+        auto message = q1.pop_front();
+        CHECK(value(*message) == i);
+        q2.push_back(std::move(message));
+    }
+    CHECK(q1.empty());
+    CHECK(q2.size() == 4);
+    q2.clear();
+    CHECK(q2.empty());
+}
+
+TEST_CASE("prioritized messages queue", "[misc]") {
+    struct sample_t {
+        int value;
+    };
+    using message_t = r::message_t<sample_t>;
+    using control_message_t = r::message::start_trigger_t;
+    auto value = [](const r::message_base_t &message) {
+        if (message.lane == r::message_lane_t::control) {
+            return 0;
+        }
+        return static_cast<const message_t &>(message).payload.value;
+    };
+    r::address_ptr_t addr;
+
+    CHECK(r::make_message<sample_t>(addr, 1)->lane == r::message_lane_t::user);
+    CHECK(r::make_message<r::payload::start_actor_t>(addr)->lane == r::message_lane_t::control);
+    CHECK(r::message_lane_trait_t<r::message::init_request_t::payload_t>::lane == r::message_lane_t::control);
+    CHECK(r::message_lane_trait_t<r::message::init_response_t::payload_t>::lane == r::message_lane_t::control);
+    CHECK(r::message_lane_trait_t<r::message::discovery_cancel_t::payload_t>::lane == r::message_lane_t::user);
+
+    r::messages_queue_t q1;
+    q1.prioritize(true);
+    CHECK(q1.is_prioritized());
+    q1.push_back(r::make_message<sample_t>(addr, 1));
+    q1.push_back(r::make_message<sample_t>(addr, 2));
+    q1.push_back(r::message_ptr_t(new control_message_t(addr)));
+    CHECK(q1.size() == 3);
+    CHECK(value(q1.front()) == 0);
+    CHECK(value(q1.back()) == 2);
+
+    r::inbound_messages_queue_t inbound;
+    inbound.push(r::message_ptr_t(new control_message_t(addr)).detach());
+    inbound.push(r::make_message<sample_t>(addr, 3).detach());
+    CHECK(inbound.drain(q1) == 2);
+    CHECK(q1.size() == 5);
+
+    r::messages_queue_t q2;
+    q2.push_back(r::make_message<sample_t>(addr, 4));
+    q2.push_back(r::message_ptr_t(new control_message_t(addr)));
+    q1.splice_back(q2);
+    CHECK(q1.size() == 7);
+    CHECK(value(*q1.pop_back()) == 4);
+    CHECK(value(*q1.pop_back()) == 3);
+
+    auto q3 = std::move(q1);
+    CHECK(q3.is_prioritized());
+    CHECK(q3.size() == 5);
+    CHECK(value(*q3.pop_front()) == 0);
+    CHECK(value(*q3.pop_front()) == 0);
+
+    q3.prioritize(false);
+    CHECK(q3.size() == 3);
+    CHECK(value(*q3.pop_front()) == 0);
+    CHECK(value(*q3.pop_front()) == 1);
+    q3.push_back(r::message_ptr_t(new control_message_t(addr)));
+    CHECK(value(q3.back()) == 0);
+    CHECK(value(*q3.pop_front()) == 2);
+    CHECK(value(*q3.pop_front()) == 0);
+    CHECK(q3.empty());
+}
+
+TEST_CASE("inbound messages queue", "[misc]") {
+    struct sample_t {
+        int value;
+    };
+    using message_t = r::message_t<sample_t>;
+    auto value = [](const r::message_base_t &message) { return static_cast<const message_t &>(message).payload.value; };
+    r::address_ptr_t addr;
+
+    r::inbound_messages_queue_t inbound;
+    r::messages_queue_t queue;
+    CHECK(inbound.empty());
+    CHECK(inbound.drain(queue) == 0);
+
+    inbound.push(r::make_message<sample_t>(addr, 1).detach());
+    CHECK(!inbound.empty());
+    CHECK(inbound.drain(queue) == 1);
+    CHECK(inbound.empty());
+    CHECK(inbound.drain(queue) == 0);
+
+    for (int i = 2; i <= 5; ++i) {
+        inbound.push(r::make_message<sample_t>(addr, i).detach());
+    }
+    r::message_base_t *ptr;
+    REQUIRE(inbound.pop(ptr));
+    auto message = r::message_ptr_t(ptr, false);
+    CHECK(value(*message) == 2);
+    queue.push_back(std::move(message));
+
+    CHECK(inbound.drain(queue) == 3);
+    CHECK(inbound.empty());
+    REQUIRE(queue.size() == 5);
+    for (int i = 1; i <= 5; ++i) {
+        auto message = queue.pop_front();
+        CHECK(value(*message) == i);
+        if (i % 2) {
+            inbound.push(message.detach());
+        }
+    }
+    CHECK(inbound.drain(queue) == 3);
+    CHECK(value(queue.front()) == 1);
+    CHECK(value(queue.back()) == 5);
+
+    r::messages_queue_t batch;
+    batch.push_back(r::make_message<sample_t>(addr, 6));
+    batch.push_back(r::make_message<sample_t>(addr, 7));
+    inbound.push(batch);
+    CHECK(batch.empty());
+    CHECK(batch.size() == 0);
+    inbound.push(batch);
+    CHECK(inbound.drain(queue) == 2);
+    CHECK(queue.size() == 5);
+    CHECK(value(queue.back()) == 7);
+    inbound.push(queue.pop_front().detach());
+}
+
+TEST_CASE("message type ids", "[misc]") {
+    struct a_t {};
+    struct b_t {};
+    using message_a_t = r::message_t<a_t>;
+    using message_b_t = r::message_t<b_t>;
+
+    CHECK(message_a_t::message_type_id != message_b_t::message_type_id);
+    CHECK(r::message_support::get_type_id(message_a_t::message_type) == message_a_t::message_type_id);
+    CHECK(r::message_support::get_type_id(message_b_t::message_type) == message_b_t::message_type_id);
+    CHECK(r::message_support::register_type_id(typeid(message_a_t)) == message_a_t::message_type_id);
+
+    auto message = r::make_message<b_t>(r::address_ptr_t{});
+    CHECK(message->type_id == message_b_t::message_type_id);
+}
@@ -96,6 +96,6 @@ TEST_CASE("ping/pong ", "[supervisor][asio]") {
     ponger.reset();
 
     io_context.run();
-    CHECK(sup->get_timers_map().size() == 0);
+    CHECK(sup->get_timers().size() == 0);
     CHECK(destroyed == 4);
 }
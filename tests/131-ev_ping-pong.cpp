@@ -24,7 +24,7 @@ struct supervisor_ev_test_t : public re::supervisor_ev_t {
         printf("~supervisor_ev_test_t\n");
     }
 
-    auto get_leader_queue() {
+    auto &get_leader_queue() {
         return static_cast<supervisor_t *>(this)->access<rt::to::locality_leader>()->access<rt::to::queue>();
     }
     auto &get_subscription() noexcept { return subscription_map; }
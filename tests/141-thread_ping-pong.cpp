@@ -25,7 +25,7 @@ struct supervisor_thread_test_t : public rth::supervisor_thread_t {
         printf("~supervisor_thread_test_t\n");
     }
 
-    auto get_leader_queue() {
+    auto &get_leader_queue() {
         return static_cast<supervisor_t *>(this)->access<rt::to::locality_leader>()->access<rt::to::queue>();
     }
     auto &get_subscription() noexcept { return subscription_map; }
@@ -116,6 +116,38 @@ struct ponger_t : public r::actor_base_t {
     }
 };
 
+struct feed_t {};
+
+struct feeder_t : public r::actor_base_t {
+    std::uint32_t fed = 0;
+    bool stopped = false;
+
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&feeder_t::on_feed); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        start_timer(r::pt::millisec{1}, *this, &feeder_t::on_timer);
+        send<feed_t>(address);
+    }
+
+    void on_feed(rotor::message_t<feed_t> &) noexcept {
+        ++fed;
+        if (!stopped) {
+            send<feed_t>(address);
+        }
+    }
+
+    void on_timer(r::request_id_t, bool) noexcept {
+        stopped = true;
+        supervisor->shutdown();
+    }
+};
+
 struct bad_actor_t : public r::actor_base_t {
     using r::actor_base_t::actor_base_t;
 
@@ -191,3 +223,21 @@ TEST_CASE("supervisors hierarchy", "[supervisor][thread]") {
     CHECK(((r::actor_base_t *)act.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
     CHECK(((r::actor_base_t *)sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
 }
+
+TEST_CASE("self-feeding actor does not starve timers", "[supervisor][thread]") {
+    auto system_context = r::intrusive_ptr_t<rth::system_context_thread_t>(new rth::system_context_thread_t());
+    auto timeout = r::pt::milliseconds{10};
+    auto sup =
+        system_context->create_supervisor<supervisor_thread_test_t>().timeout(timeout).process_budget(100).finish();
+    auto feeder = sup->create_actor<feeder_t>().timeout(timeout).finish();
+
+    sup->start();
+    system_context->run();
+
+    CHECK(feeder->stopped);
+    CHECK(feeder->fed > 0);
+    CHECK(sup->get_process_stats().budget_hits > 0);
+    CHECK(sup->get_process_stats().slice_hits == 0);
+    CHECK(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+    CHECK(sup->get_leader_queue().size() == 0);
+}
@@ -172,6 +172,48 @@ struct io_actor3_t : public r::actor_base_t {
     }
 };
 
+struct periodic_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+    using clock_t = std::chrono::steady_clock;
+
+    clock_t::time_point started;
+    clock_t::duration elapsed;
+    int triggerings = 0;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        started = clock_t::now();
+        start_periodic_timer(r::pt::milliseconds(2), *this, &periodic_actor_t::on_timer);
+    }
+
+    void on_timer(r::request_id_t timer_id, bool cancelled) noexcept {
+        if (!cancelled && ++triggerings == 5) {
+            elapsed = clock_t::now() - started;
+            cancel_timer(timer_id);
+            supervisor->do_shutdown();
+        }
+    }
+};
+
+struct sleepy_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    int triggerings = 0;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        for (int i = 1; i <= 20; ++i) {
+            start_timer(r::pt::microseconds(i * 500), *this, &sleepy_actor_t::on_timer);
+        }
+    }
+
+    void on_timer(r::request_id_t, bool cancelled) noexcept {
+        if (!cancelled && ++triggerings == 20) {
+            supervisor->do_shutdown();
+        }
+    }
+};
+
 TEST_CASE("timer", "[supervisor][thread]") {
     auto system_context = rth::system_context_thread_t();
     auto timeout = r::pt::milliseconds{100};
@@ -228,3 +270,35 @@ TEST_CASE("has I/O tag, correct timers", "[supervisor][thread]") {
     REQUIRE(actor->ee->ec == r::error_code_t::request_timeout);
     REQUIRE(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
 }
+
+TEST_CASE("periodic timer", "[supervisor][thread]") {
+    auto system_context = rth::system_context_thread_t();
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = system_context.create_supervisor<rth::supervisor_thread_t>().timeout(timeout).finish();
+    auto actor = sup->create_actor<periodic_actor_t>().timeout(timeout).finish();
+
+    sup->start();
+    system_context.run();
+
+    REQUIRE(actor->triggerings == 5);
+    REQUIRE(actor->elapsed >= std::chrono::milliseconds(9));
+    REQUIRE(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("timer slack", "[supervisor][thread]") {
+    auto system_context = rth::system_context_thread_t();
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = system_context.create_supervisor<rth::supervisor_thread_t>()
+                   .timeout(timeout)
+                   .timer_slack(r::pt::milliseconds{50})
+                   .finish();
+    auto actor = sup->create_actor<sleepy_actor_t>().timeout(timeout).finish();
+
+    sup->start();
+    system_context.run();
+
+    REQUIRE(actor->triggerings == 20);
+    // the deadlines might be split by the bucket boundary
+    REQUIRE(system_context.get_timer_wakeups() <= 2);
+    REQUIRE(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
@@ -6119,7 +6119,7 @@ namespace Catch {
         static bool isSet;
         static struct sigaction oldSigActions[];
         static stack_t oldSigStack;
-        static char altStackMem[];
+        static char* altStackMem;
 
         static void handleSignal( int sig );
 
@@ -8745,8 +8745,11 @@ namespace Catch {
     };
 
     // 32kb for the alternate stack seems to be sufficient. However, this value
-    // is experimentally determined, so that's not guaranteed.
-    constexpr static std::size_t sigStackSize = 32768 >= MINSIGSTKSZ ? 32768 : MINSIGSTKSZ;
+    // is experimentally determined, so that's not guaranteed. Since glibc 2.34
+    // MINSIGSTKSZ is not a constant expression, so the stack is sized at runtime.
+    static std::size_t sigStackSize() {
+        return 32768 >= MINSIGSTKSZ ? 32768 : static_cast<std::size_t>(MINSIGSTKSZ);
+    }
 
     static SignalDefs signalDefs[] = {
         { SIGINT,  "SIGINT - Terminal interrupt signal" },
@@ -8773,8 +8776,11 @@ namespace Catch {
     FatalConditionHandler::FatalConditionHandler() {
         isSet = true;
         stack_t sigStack;
+        if (!altStackMem) {
+            altStackMem = new char[sigStackSize()]();
+        }
         sigStack.ss_sp = altStackMem;
-        sigStack.ss_size = sigStackSize;
+        sigStack.ss_size = sigStackSize();
         sigStack.ss_flags = 0;
         sigaltstack(&sigStack, &oldSigStack);
         struct sigaction sa = { };
@@ -8805,7 +8811,7 @@ namespace Catch {
     bool FatalConditionHandler::isSet = false;
     struct sigaction FatalConditionHandler::oldSigActions[sizeof(signalDefs)/sizeof(SignalDefs)] = {};
     stack_t FatalConditionHandler::oldSigStack = {};
-    char FatalConditionHandler::altStackMem[sigStackSize] = {};
+    char* FatalConditionHandler::altStackMem = nullptr;
 
 } // namespace Catch
 
@@ -28,16 +28,17 @@ supervisor_test_t::~supervisor_test_t() { printf("~supervisor_test_t, %p(%p)\n",
 address_ptr_t supervisor_test_t::make_address() noexcept { return instantiate_address(locality); }
 
 void supervisor_test_t::do_start_timer(const pt::time_duration &, timer_handler_base_t& handler) noexcept {
-    printf("starting timer %zu (%p)\n", handler.request_id, (void*)this);
+    printf("starting timer %llu (%p)\n", (unsigned long long)handler.request_id, (void*)this);
     active_timers.emplace_back(&handler);
 }
 
-void supervisor_test_t::do_cancel_timer(request_id_t timer_id) noexcept {
-    printf("cancelling timer %zu (%p)\n", timer_id, (void*)this);
+void supervisor_test_t::do_cancel_timer(timer_handler_base_t &timer_handler) noexcept {
+    auto timer_id = timer_handler.request_id;
+    printf("cancelling timer %llu (%p)\n", (unsigned long long)timer_id, (void*)this);
     auto it = active_timers.begin();
     while (it != active_timers.end()) {
         auto& handler = *it;
-        if (handler->request_id == timer_id) {
+        if (handler == &timer_handler) {
             auto& actor_ptr = handler->owner;
             actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, true);
             active_timers.erase(it);
@@ -50,14 +51,14 @@ void supervisor_test_t::do_cancel_timer(request_id_t timer_id) noexcept {
 }
 
 void supervisor_test_t::do_invoke_timer(request_id_t timer_id) noexcept {
-    printf("invoking timer %zu (%p)\n", timer_id, (void*)this);
+    printf("invoking timer %llu (%p)\n", (unsigned long long)timer_id, (void*)this);
     auto predicate = [&](auto& handler) { return handler->request_id == timer_id;  };
     auto it = std::find_if(active_timers.begin(), active_timers.end(), predicate);
     assert(it != active_timers.end());
-    auto& handler = *it;
-    auto& actor_ptr = handler->owner;
-    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
+    auto actor_ptr = (*it)->owner;
+    // the handler might re-arm or cancel timers, so the timer is unlinked before the invocation
     active_timers.erase(it);
+    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
 }
 
 
@@ -74,7 +75,7 @@ request_id_t supervisor_test_t::get_timer(std::size_t index) noexcept {
     return (*it)->request_id;
 }
 
-void supervisor_test_t::enqueue(message_ptr_t message) noexcept { get_leader().queue.emplace_back(std::move(message)); }
+void supervisor_test_t::enqueue(message_ptr_t message) noexcept { get_leader().queue.push_back(std::move(message)); }
 
 pt::time_duration rotor::test::default_timeout{pt::milliseconds{1}};
 
@@ -106,8 +107,7 @@ system_test_context_t::~system_test_context_t() {
         auto& queue = sup->access<to::queue>();
         auto& inbound = sup->access<to::inbound_queue>();
         while(!queue.empty()) {
-            inbound.push(queue.front().detach());
-            queue.pop_front();
+            inbound.push(queue.pop_front().detach());
         }
     }
 }
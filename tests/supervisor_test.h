@@ -37,7 +37,7 @@ struct supervisor_test_t : public supervisor_t {
 
     void configure(plugin::plugin_base_t &plugin) noexcept override;
     virtual void do_start_timer(const pt::time_duration &interval, timer_handler_base_t& handler) noexcept override;
-    virtual void do_cancel_timer(request_id_t timer_id) noexcept override;
+    virtual void do_cancel_timer(timer_handler_base_t &handler) noexcept override;
     void do_invoke_timer(request_id_t timer_id) noexcept;
     request_id_t get_timer(std::size_t index) noexcept;
     virtual void start() noexcept override {}
@@ -52,7 +52,7 @@ struct supervisor_test_t : public supervisor_t {
     subscription_container_t &get_points() noexcept;
     subscription_t &get_subscription() noexcept { return subscription_map; }
     size_t get_children_count() noexcept;
-    request_map_t &get_requests() noexcept { return request_map; }
+    request_table_t &get_requests() noexcept { return get_leader().request_table; }
 
     auto get_activating_plugins() noexcept { return this->activating_plugins; }
     auto get_deactivating_plugins() noexcept { return this->deactivating_plugins; }